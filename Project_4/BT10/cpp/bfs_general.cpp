@@ -1,6 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <string>
+
+#include "../../../common/graph_loader.h" // Graph files in every format (.inp, DIMACS, SGB, .bin, .nga)
 
 // Breadth-first search algorithm for a general graph (repeated edges and loops allowed)
 // Author: Nguyễn Ngọc Thạch
@@ -9,7 +12,8 @@
 using namespace std;
 
 // BFS function for general graph
-void bfs(const vector<vector<int>>& adj, int start) {
+template <typename Graph> // vector<vector<int>> or BinaryGraph::Adjacency
+void bfs(const Graph& adj, int start) {
     int n = adj.size();
     vector<bool> visited(n, false);
     queue<int> q;
@@ -28,7 +32,30 @@ void bfs(const vector<vector<int>>& adj, int start) {
     }
 }
 
-int main() {
+// Runs BFS on a graph file in any format of common/graph_loader.h (.inp,
+// DIMACS, SGB, .bin or .nga). A .bin file is memory-mapped and used without parsing.
+// The starting vertex is start_arg if given, else the one after the edges of an .inp file;
+// nothing is read from the keyboard, so the tool can run in scripts.
+int run_file(const char* path, const char* start_arg) {
+    BinaryGraph graph;
+    GraphFileInfo info;
+    string error;
+    int start;
+    if (!load_graph(path, graph, error, &info) ||
+        !choose_start_vertex(start_arg, info, graph.n(), "starting vertex", start, error)) {
+        cerr << "Error: " << error << endl;
+        return 1;
+    }
+    cout << "BFS traversal: ";
+    bfs(graph.adjacency(), start);
+    cout << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Graph file, and optionally the starting vertex, given on the command line
+    if (argc > 1) return run_file(argv[1], argc > 2 ? argv[2] : nullptr);
+
     int n, m;
     cout << "Enter number of vertices and edges: ";
     cin >> n >> m;
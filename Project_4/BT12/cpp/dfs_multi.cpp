@@ -1,6 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <stack>
+#include <string>
+
+#include "../../../common/graph_loader.h" // Graph files in every format (.inp, DIMACS, SGB, .bin, .nga)
 
 // Depth-first search algorithm for a finite multigraph (no loops, repeated edges allowed)
 // Author: Nguyễn Ngọc Thạch
@@ -9,7 +12,8 @@
 using namespace std;
 
 // Recursive DFS for multigraph
-void dfs_recursive(const vector<vector<int>>& adj, vector<bool>& visited, int vertex) {
+template <typename Graph> // vector<vector<int>> or BinaryGraph::Adjacency
+void dfs_recursive(const Graph& adj, vector<bool>& visited, int vertex) {
     visited[vertex] = true;
     cout << vertex << " ";
     for (int neighbor : adj[vertex]) {
@@ -20,7 +24,8 @@ void dfs_recursive(const vector<vector<int>>& adj, vector<bool>& visited, int ve
 }
 
 // Iterative DFS for multigraph
-void dfs_iterative(const vector<vector<int>>& adj, int start) {
+template <typename Graph> // vector<vector<int>> or BinaryGraph::Adjacency
+void dfs_iterative(const Graph& adj, int start) {
     int n = adj.size();
     vector<bool> visited(n, false);
     stack<int> s;
@@ -41,7 +46,39 @@ void dfs_iterative(const vector<vector<int>>& adj, int start) {
     }
 }
 
-int main() {
+// Runs both DFS variants on a graph file in any format of common/graph_loader.h
+// (.inp, DIMACS, SGB, .bin or .nga). A .bin file is memory-mapped and used without parsing.
+// The starting vertex is start_arg if given, else the one after the edges of an .inp file;
+// nothing is read from the keyboard, so the tool can run in scripts. Loops in the file are
+// skipped with the message of the keyboard input.
+int run_file(const char* path, const char* start_arg) {
+    BinaryGraph graph;
+    GraphFileInfo info;
+    string error;
+    int start;
+    if (!load_graph(path, graph, error, &info) ||
+        !choose_start_vertex(start_arg, info, graph.n(), "starting vertex", start, error)) {
+        cerr << "Error: " << error << endl;
+        return 1;
+    }
+    remove_loops(graph, [](int v) {
+        cout << "Loops are not allowed in a multigraph. Skipping edge (" << v << ", " << v << ").\n";
+    });
+    BinaryGraph::Adjacency adj = graph.adjacency();
+    cout << "\nDFS using recursion: ";
+    vector<bool> visited(graph.n(), false);
+    dfs_recursive(adj, visited, start);
+    cout << endl;
+    cout << "DFS using iteration: ";
+    dfs_iterative(adj, start);
+    cout << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Graph file, and optionally the starting vertex, given on the command line
+    if (argc > 1) return run_file(argv[1], argc > 2 ? argv[2] : nullptr);
+
     int n, m;
     cout << "Enter number of vertices and edges: ";
     cin >> n >> m;
@@ -5,6 +5,22 @@
 #include <string>
 #include <set> // Still useful for mapToExtended to collect unique edges before expanding
 #include <algorithm> // For std::min and std::max
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <cstdlib>
+#include <thread> // Parallel conversions; build with -pthread
+
+#include "../../../common/graph_loader.h" // Graph files in every format (.inp, DIMACS, SGB, .bin, .nga)
+#include "../../../common/footprint.h"    // Heap footprint of the representations
+#include "../../../common/graph_fingerprint.h" // Round-trip checks in batch mode
+#include "../../../common/triangles.h"         // Triangle counts and clustering coefficients
+#include "../../../common/conversion_bench.h"  // --bench grid and heap counters
+#include "../../../common/represent_batch.h"    // --batch driver shared by the represent tools
+#include "../../../common/edge_csr.h"          // Parallel radix-sort incidence index
 
 using namespace std;
 
@@ -34,6 +50,77 @@ struct AdjacencyMap {
     int m; // Total number of edge instances
 };
 
+int conversionThreadCount(int work); // Defined with the parallel conversion kernels
+
+// Canonical edge store shared by the zero-copy views below.
+// Every undirected edge instance is stored exactly once as (min(u,v), max(u,v)),
+// sorted, so edge ids match the ones listToExtended would assign. A loop typed in once is two
+// instances, since the adjacency list holds it twice (see main).
+// The incidence index (CSR: edge ids incident to v are incident[offset[v] .. offset[v+1]))
+// is only built on first use by a view that needs per-vertex access, with the parallel
+// radix sort of common/edge_csr.h.
+// Together with the index the store is the Extended Adjacency List in CSR form.
+struct EdgeStore {
+    vector<pair<int, int>> edges;
+    int n = 0;
+    mutable vector<int> offset;
+    mutable vector<int> incident;
+    mutable bool indexed = false;
+
+    void ensureIndex() const {
+        if (indexed) return;
+        build_incidence_csr(n, edges, conversionThreadCount((int)edges.size()), offset, incident);
+        indexed = true;
+    }
+
+    int degree(int v) const {
+        ensureIndex();
+        return offset[v + 1] - offset[v];
+    }
+
+    // k-th edge id incident to v, in increasing id order
+    int incidentEdge(int v, int k) const {
+        ensureIndex();
+        return incident[offset[v] + k];
+    }
+
+    int opposite(int v, int edge_idx) const {
+        const auto& e = edges[edge_idx];
+        return e.first == v ? e.second : e.first;
+    }
+};
+
+// Views: O(1) to construct, they only point at the store.
+struct AdjacencyListView {
+    const EdgeStore* store = nullptr;
+    int n = 0;
+
+    int degree(int u) const { return store->degree(u); }
+    int neighbor(int u, int k) const { return store->opposite(u, store->incidentEdge(u, k)); }
+};
+
+struct ExtendedAdjacencyListView {
+    const EdgeStore* store = nullptr;
+    int n = 0, m = 0;
+
+    const vector<pair<int, int>>& edges() const { return store->edges; }
+    // For undirected graphs the outgoing and incoming edge lists of a vertex coincide.
+    int degree(int v) const { return store->degree(v); }
+    int incidentEdge(int v, int k) const { return store->incidentEdge(v, k); }
+};
+
+struct AdjacencyMapView {
+    const EdgeStore* store = nullptr;
+    int n = 0, m = 0;
+
+    int degree(int u) const { return store->degree(u); }
+    // {neighbor_v, canonical_edge_tuple}; the stored edge already is the canonical tuple
+    pair<int, pair<int, int>> entry(int u, int k) const {
+        int edge_idx = store->incidentEdge(u, k);
+        return {store->opposite(u, edge_idx), store->edges[edge_idx]};
+    }
+};
+
 // Enum for current representation
 enum Representation {
     ADJ_LIST,
@@ -42,11 +129,14 @@ enum Representation {
     ADJ_MAP
 };
 
-// Global variables to track current state
-AdjacencyList current_list;
+// Global variables to track current state.
+// The graph itself lives once in current_store; list, extended and map are views over it.
+// Only the matrix is materialized, since it cannot be derived from the store in O(1).
+EdgeStore current_store;
+AdjacencyListView current_list;
 AdjacencyMatrix current_matrix;
-ExtendedAdjacencyList current_extended;
-AdjacencyMap current_map;
+ExtendedAdjacencyListView current_extended;
+AdjacencyMapView current_map;
 Representation current_rep = ADJ_LIST;
 
 
@@ -325,6 +415,10 @@ AdjacencyMap extendedToMap(const ExtendedAdjacencyList& ext) {
 
         map.outgoing[u].push_back({v, canonical_edge});
         map.incoming[v].push_back({u, canonical_edge}); // For undirected graph
+        if (u != v) { // The reverse connection, as listToMap has it; mapToExtended relies on it
+            map.outgoing[v].push_back({u, canonical_edge});
+            map.incoming[u].push_back({v, canonical_edge});
+        }
     }
     return map;
 }
@@ -380,68 +474,474 @@ ExtendedAdjacencyList mapToExtended(const AdjacencyMap& map) {
     return ext;
 }
 
+// ========== PARALLEL CONVERSION KERNELS ==========
+// Multi-threaded versions of the 12 conversions above. Vertices (or edges) are split into
+// contiguous blocks, one per thread. Outputs that are scattered to other vertices are built
+// in two passes: every thread first counts what it will write to each vertex, a prefix sum
+// over (vertex, thread) then fixes where each thread writes, and the second pass fills the
+// output in place. Since the blocks are in serial order, every per-vertex list comes out in
+// exactly the order the serial conversion produces, independent of the thread count.
+// For maps the per-vertex vectors are identical; the unordered_maps compare equal.
+
+// Number of threads used by the parallel conversions; 0 means one per hardware thread.
+int conversion_threads = 0;
+
+int conversionThreadCount(int work) {
+    int threads = conversion_threads > 0 ? conversion_threads : (int)thread::hardware_concurrency();
+    return max(1, min(threads, work));
+}
+
+// Runs body(t, begin, end) for the t-th of 'threads' contiguous blocks of [0, n).
+// Block 0 runs on the calling thread.
+template <class Body>
+void parallelBlocks(int n, int threads, Body body) {
+    vector<thread> workers;
+    for (int t = 1; t < threads; ++t) {
+        workers.emplace_back(body, t, (int)((long long)n * t / threads), (int)((long long)n * (t + 1) / threads));
+    }
+    body(0, 0, (int)((long long)n / threads));
+    for (auto& w : workers) w.join();
+}
+
+// Two-pass bucket fill: emit(item, put) calls put(bucket, value) for every value the
+// serial conversion would push to bucket while processing item.
+template <class Value, class Emit>
+vector<vector<Value>> parallelBuckets(int n_items, int n_buckets, int threads, Emit emit) {
+    vector<vector<int>> pos(threads, vector<int>(n_buckets, 0));
+    parallelBlocks(n_items, threads, [&](int t, int begin, int end) {
+        vector<int>& count = pos[t];
+        for (int i = begin; i < end; ++i) {
+            emit(i, [&](int bucket, const Value&) { count[bucket]++; });
+        }
+    });
+
+    vector<vector<Value>> buckets(n_buckets);
+    parallelBlocks(n_buckets, threads, [&](int, int begin, int end) {
+        for (int b = begin; b < end; ++b) {
+            int total = 0;
+            for (int t = 0; t < threads; ++t) {
+                int count = pos[t][b];
+                pos[t][b] = total; // Where thread t starts writing in bucket b
+                total += count;
+            }
+            buckets[b].resize(total);
+        }
+    });
+
+    parallelBlocks(n_items, threads, [&](int t, int begin, int end) {
+        vector<int>& next = pos[t];
+        for (int i = begin; i < end; ++i) {
+            emit(i, [&](int bucket, const Value& value) { buckets[bucket][next[bucket]++] = value; });
+        }
+    });
+    return buckets;
+}
+
+// Allocates an n x n zero matrix, rows in parallel.
+AdjacencyMatrix zeroMatrixParallel(int n, int threads) {
+    AdjacencyMatrix matrix;
+    matrix.n = n;
+    matrix.matrix.resize(n);
+    parallelBlocks(n, threads, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) matrix.matrix[i].assign(n, 0);
+    });
+    return matrix;
+}
+
+// Sets both incoming and outgoing of ext from the incidence lists, which coincide for
+// every undirected conversion above.
+void setIncidenceParallel(ExtendedAdjacencyList& ext, int threads) {
+    ext.outgoing = parallelBuckets<int>(ext.m, ext.n, threads, [&](int idx, auto put) {
+        put(ext.edges[idx].first, idx);
+        if (ext.edges[idx].first != ext.edges[idx].second) put(ext.edges[idx].second, idx);
+    });
+    ext.incoming.resize(ext.n);
+    parallelBlocks(ext.n, threads, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v) ext.incoming[v] = ext.outgoing[v];
+    });
+}
+
+// Builds ext.edges in canonical order from per-vertex buckets of canonical partners:
+// canonical[u] holds v for every appearance of the canonical edge (u,v), u <= v.
+// Non-loop edges appear twice per instance and loops once, as in listToExtended/mapToExtended.
+ExtendedAdjacencyList extendedFromCanonicalParallel(int n, vector<vector<int>>& canonical, int threads) {
+    ExtendedAdjacencyList ext;
+    ext.n = n;
+
+    vector<long long> first_edge(n + 1, 0);
+    parallelBlocks(n, threads, [&](int, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            vector<int>& partners = canonical[u];
+            sort(partners.begin(), partners.end());
+            // Compact to the edge instances: halve the runs of non-loop partners
+            size_t out = 0;
+            for (size_t i = 0; i < partners.size();) {
+                size_t j = i;
+                while (j < partners.size() && partners[j] == partners[i]) j++;
+                size_t count = partners[i] == u ? j - i : (j - i) / 2;
+                for (size_t k = 0; k < count; ++k) partners[out++] = partners[i];
+                i = j;
+            }
+            partners.resize(out);
+            first_edge[u + 1] = out;
+        }
+    });
+    for (int u = 0; u < n; ++u) first_edge[u + 1] += first_edge[u];
+
+    ext.m = first_edge[n];
+    ext.edges.resize(ext.m);
+    parallelBlocks(n, threads, [&](int, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            for (size_t k = 0; k < canonical[u].size(); ++k) {
+                ext.edges[first_edge[u] + k] = {u, canonical[u][k]};
+            }
+        }
+    });
+    canonical = vector<vector<int>>();
+
+    setIncidenceParallel(ext, threads);
+    return ext;
+}
+
+// Moves non-empty per-vertex vectors into an AdjacencyMap side, in vertex order.
+void fillMapSide(unordered_map<int, vector<pair<int, pair<int, int>>>>& side,
+                 vector<vector<pair<int, pair<int, int>>>>& lists) {
+    side.reserve(lists.size());
+    for (int u = 0; u < (int)lists.size(); ++u) {
+        if (!lists[u].empty()) side[u] = std::move(lists[u]);
+    }
+}
+
+AdjacencyMatrix listToMatrixParallel(const AdjacencyList& list) {
+    int threads = conversionThreadCount(list.n);
+    AdjacencyMatrix matrix = zeroMatrixParallel(list.n, threads);
+    parallelBlocks(list.n, threads, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            for (int j : list.adj[i]) matrix.matrix[i][j]++;
+        }
+    });
+    return matrix;
+}
+
+AdjacencyList matrixToListParallel(const AdjacencyMatrix& matrix) {
+    int threads = conversionThreadCount(matrix.n);
+    AdjacencyList list;
+    list.n = matrix.n;
+    list.adj.resize(list.n);
+    parallelBlocks(matrix.n, threads, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            for (int j = 0; j < matrix.n; ++j) {
+                for (int k = 0; k < matrix.matrix[i][j]; ++k) list.adj[i].push_back(j);
+            }
+        }
+    });
+    return list;
+}
+
+ExtendedAdjacencyList matrixToExtendedParallel(const AdjacencyMatrix& matrix) {
+    int threads = conversionThreadCount(matrix.n);
+    ExtendedAdjacencyList ext;
+    ext.n = matrix.n;
+
+    // Edges are numbered row by row over the upper triangle (i <= j)
+    vector<long long> first_edge(matrix.n + 1, 0);
+    parallelBlocks(matrix.n, threads, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            long long count = 0;
+            for (int j = i; j < matrix.n; ++j) count += matrix.matrix[i][j];
+            first_edge[i + 1] = count;
+        }
+    });
+    for (int i = 0; i < matrix.n; ++i) first_edge[i + 1] += first_edge[i];
+
+    ext.m = first_edge[matrix.n];
+    ext.edges.resize(ext.m);
+    parallelBlocks(matrix.n, threads, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            long long idx = first_edge[i];
+            for (int j = i; j < matrix.n; ++j) {
+                for (int k = 0; k < matrix.matrix[i][j]; ++k) ext.edges[idx++] = {i, j};
+            }
+        }
+    });
+
+    setIncidenceParallel(ext, conversionThreadCount(max(ext.m, ext.n)));
+    return ext;
+}
+
+AdjacencyMatrix extendedToMatrixParallel(const ExtendedAdjacencyList& ext) {
+    // Bucket the edges by matrix row first, so every thread owns a block of rows
+    int threads = conversionThreadCount(max(ext.m, ext.n));
+    vector<vector<int>> row_cells = parallelBuckets<int>(ext.m, ext.n, threads, [&](int idx, auto put) {
+        int u = ext.edges[idx].first;
+        int v = ext.edges[idx].second;
+        put(u, v);
+        if (u != v) put(v, u);
+    });
+
+    AdjacencyMatrix matrix = zeroMatrixParallel(ext.n, threads);
+    parallelBlocks(ext.n, threads, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            for (int j : row_cells[i]) matrix.matrix[i][j]++;
+        }
+    });
+    return matrix;
+}
+
+AdjacencyMap matrixToMapParallel(const AdjacencyMatrix& matrix) {
+    int threads = conversionThreadCount(matrix.n);
+    vector<vector<pair<int, pair<int, int>>>> outgoing(matrix.n), incoming(matrix.n);
+    vector<long long> row_size(matrix.n, 0);
+    parallelBlocks(matrix.n, threads, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            for (int j = 0; j < matrix.n; ++j) {
+                // Row i gives outgoing[i]; column i gives incoming[i] in the serial push order
+                for (int k = 0; k < matrix.matrix[i][j]; ++k) outgoing[i].push_back({j, {min(i, j), max(i, j)}});
+                for (int k = 0; k < matrix.matrix[j][i]; ++k) incoming[i].push_back({j, {min(i, j), max(i, j)}});
+            }
+            row_size[i] = outgoing[i].size();
+        }
+    });
+
+    AdjacencyMap map;
+    map.n = matrix.n;
+    long long total = 0;
+    for (long long size : row_size) total += size;
+    map.m = total / 2;
+    fillMapSide(map.outgoing, outgoing);
+    fillMapSide(map.incoming, incoming);
+    return map;
+}
+
+AdjacencyMatrix mapToMatrixParallel(const AdjacencyMap& map) {
+    int threads = conversionThreadCount(map.n);
+    AdjacencyMatrix matrix = zeroMatrixParallel(map.n, threads);
+    parallelBlocks(map.n, threads, [&](int, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            auto it = map.outgoing.find(u);
+            if (it == map.outgoing.end()) continue;
+            for (const auto& edge_info : it->second) matrix.matrix[u][edge_info.first]++;
+        }
+    });
+    return matrix;
+}
+
+ExtendedAdjacencyList listToExtendedParallel(const AdjacencyList& list) {
+    int threads = conversionThreadCount(list.n);
+    vector<vector<int>> canonical = parallelBuckets<int>(list.n, list.n, threads, [&](int i, auto put) {
+        for (int j : list.adj[i]) put(min(i, j), max(i, j));
+    });
+    return extendedFromCanonicalParallel(list.n, canonical, threads);
+}
+
+AdjacencyList extendedToListParallel(const ExtendedAdjacencyList& ext) {
+    int threads = conversionThreadCount(max(ext.m, ext.n));
+    AdjacencyList list;
+    list.n = ext.n;
+    list.adj = parallelBuckets<int>(ext.m, ext.n, threads, [&](int idx, auto put) {
+        int u = ext.edges[idx].first;
+        int v = ext.edges[idx].second;
+        put(u, v);
+        if (u != v) put(v, u);
+    });
+    return list;
+}
+
+AdjacencyMap listToMapParallel(const AdjacencyList& list) {
+    int threads = conversionThreadCount(list.n);
+    vector<vector<pair<int, pair<int, int>>>> outgoing(list.n);
+    vector<long long> row_size(list.n, 0);
+    parallelBlocks(list.n, threads, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            outgoing[i].reserve(list.adj[i].size());
+            for (int j : list.adj[i]) outgoing[i].push_back({j, {min(i, j), max(i, j)}});
+            row_size[i] = outgoing[i].size();
+        }
+    });
+    auto incoming = parallelBuckets<pair<int, pair<int, int>>>(list.n, list.n, threads, [&](int i, auto put) {
+        for (int j : list.adj[i]) put(j, {i, {min(i, j), max(i, j)}});
+    });
+
+    AdjacencyMap map;
+    map.n = list.n;
+    long long total = 0;
+    for (long long size : row_size) total += size;
+    map.m = total / 2;
+    fillMapSide(map.outgoing, outgoing);
+    fillMapSide(map.incoming, incoming);
+    return map;
+}
+
+AdjacencyList mapToListParallel(const AdjacencyMap& map) {
+    int threads = conversionThreadCount(map.n);
+    AdjacencyList list;
+    list.n = map.n;
+    list.adj.resize(list.n);
+    parallelBlocks(map.n, threads, [&](int, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            auto it = map.outgoing.find(u);
+            if (it == map.outgoing.end()) continue;
+            list.adj[u].reserve(it->second.size());
+            for (const auto& edge_info : it->second) list.adj[u].push_back(edge_info.first);
+        }
+    });
+    return list;
+}
+
+AdjacencyMap extendedToMapParallel(const ExtendedAdjacencyList& ext) {
+    int threads = conversionThreadCount(max(ext.m, ext.n));
+    // outgoing[x] and incoming[x] receive the same entries for every edge, see extendedToMap
+    auto outgoing = parallelBuckets<pair<int, pair<int, int>>>(ext.m, ext.n, threads, [&](int idx, auto put) {
+        int u = ext.edges[idx].first;
+        int v = ext.edges[idx].second;
+        pair<int, int> canonical_edge = {min(u, v), max(u, v)};
+        put(u, {v, canonical_edge});
+        if (u != v) put(v, {u, canonical_edge});
+    });
+
+    AdjacencyMap map;
+    map.n = ext.n;
+    map.m = ext.m;
+    auto incoming = outgoing;
+    fillMapSide(map.outgoing, outgoing);
+    fillMapSide(map.incoming, incoming);
+    return map;
+}
+
+ExtendedAdjacencyList mapToExtendedParallel(const AdjacencyMap& map) {
+    int threads = conversionThreadCount(map.n);
+    vector<vector<int>> canonical = parallelBuckets<int>(map.n, map.n, threads, [&](int u, auto put) {
+        auto it = map.outgoing.find(u);
+        if (it == map.outgoing.end()) return;
+        for (const auto& edge_info : it->second) put(edge_info.second.first, edge_info.second.second);
+    });
+    return extendedFromCanonicalParallel(map.n, canonical, threads);
+}
+
+// ========== ZERO-COPY VIEW CONSTRUCTION ==========
+
+// Builds the canonical store from raw edge instances (any orientation, loops allowed).
+EdgeStore makeEdgeStore(int n, vector<pair<int, int>> edges) {
+    EdgeStore store;
+    store.n = n;
+    for (auto& e : edges) {
+        if (e.first > e.second) swap(e.first, e.second);
+    }
+    sort(edges.begin(), edges.end());
+    store.edges = std::move(edges);
+    return store;
+}
+
+// Extended Adjacency List in CSR form over a raw edge array in input order: edges[i] is the
+// i-th input edge as given (either orientation), and the ids of the edges incident to v are
+// incident[offset[v] .. offset[v+1]). It is not canonical like EdgeStore, so the views do not
+// take it; makeEdgeStore builds the canonical form.
+struct InputOrderEAL {
+    vector<pair<int, int>> edges;
+    int n = 0;
+    vector<int> offset;
+    vector<int> incident;
+};
+
+// Builds the input-order Extended Adjacency List straight from a raw edge array, without
+// sorting or reorienting the edges.
+InputOrderEAL edgesToInputOrderEAL(int n, vector<pair<int, int>> edges) {
+    InputOrderEAL eal;
+    eal.n = n;
+    eal.edges = std::move(edges);
+    build_incidence_csr(n, eal.edges, conversionThreadCount((int)eal.edges.size()), eal.offset, eal.incident);
+    return eal;
+}
+
+AdjacencyListView makeListView(const EdgeStore& store) {
+    return {&store, store.n};
+}
+
+ExtendedAdjacencyListView makeExtendedView(const EdgeStore& store) {
+    return {&store, store.n, (int)store.edges.size()};
+}
+
+AdjacencyMapView makeMapView(const EdgeStore& store) {
+    return {&store, store.n, (int)store.edges.size()};
+}
+
+// The matrix is the one representation that has to be materialized.
+// Cells are filled exactly as extendedToMatrix does.
+AdjacencyMatrix storeToMatrix(const EdgeStore& store) {
+    AdjacencyMatrix matrix;
+    matrix.n = store.n;
+    matrix.matrix.assign(matrix.n, vector<int>(matrix.n, 0));
+    for (const auto& edge : store.edges) {
+        matrix.matrix[edge.first][edge.second]++;
+        if (edge.first != edge.second) {
+            matrix.matrix[edge.second][edge.first]++;
+        }
+    }
+    return matrix;
+}
+
 // Display functions
-void displayMatrix(const AdjacencyMatrix& matrix) {
-    cout << "Adjacency Matrix:\n";
-    cout << "   ";
+void displayMatrix(const AdjacencyMatrix& matrix, ostream& out = cout) {
+    out << "Adjacency Matrix:\n";
+    out << "   ";
     for (int i = 0; i < matrix.n; i++) {
-        cout << i << " ";
+        out << i << " ";
     }
-    cout << "\n";
+    out << "\n";
 
     for (int i = 0; i < matrix.n; i++) {
-        cout << i << "  ";
+        out << i << "  ";
         for (int j = 0; j < matrix.n; j++) {
-            cout << matrix.matrix[i][j] << " ";
+            out << matrix.matrix[i][j] << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayList(const AdjacencyList& list) {
-    cout << "Adjacency List:\n";
+void displayList(const AdjacencyList& list, ostream& out = cout) {
+    out << "Adjacency List:\n";
     for (int i = 0; i < list.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int j : list.adj[i]) {
-            cout << j << " ";
+            out << j << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayExtended(const ExtendedAdjacencyList& ext) {
-    cout << "Extended Adjacency List:\n";
-    cout << "Total Edges (m): " << ext.m << "\n";
-    cout << "Edges (u,v) and their indices:\n";
+void displayExtended(const ExtendedAdjacencyList& ext, ostream& out = cout) {
+    out << "Extended Adjacency List:\n";
+    out << "Total Edges (m): " << ext.m << "\n";
+    out << "Edges (u,v) and their indices:\n";
     for (int i = 0; i < ext.edges.size(); i++) {
-        cout << "  Edge " << i << ": (" << ext.edges[i].first << "," << ext.edges[i].second << ")\n";
+        out << "  Edge " << i << ": (" << ext.edges[i].first << "," << ext.edges[i].second << ")\n";
     }
 
-    cout << "Outgoing edges (indices):\n";
+    out << "Outgoing edges (indices):\n";
     for (int i = 0; i < ext.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int edge_idx : ext.outgoing[i]) {
-            cout << edge_idx << " ";
+            out << edge_idx << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 
-    cout << "Incoming edges (indices):\n";
+    out << "Incoming edges (indices):\n";
     for (int i = 0; i < ext.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int edge_idx : ext.incoming[i]) {
-            cout << edge_idx << " ";
+            out << edge_idx << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayMap(const AdjacencyMap& map) {
-    cout << "Adjacency Map:\n";
-    cout << "Total Edges (m): " << map.m << "\n";
-    cout << "Outgoing mappings:\n";
+void displayMap(const AdjacencyMap& map, ostream& out = cout) {
+    out << "Adjacency Map:\n";
+    out << "Total Edges (m): " << map.m << "\n";
+    out << "Outgoing mappings:\n";
     for (int i = 0; i < map.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         auto it = map.outgoing.find(i);
         if (it != map.outgoing.end()) {
             // Sorting for consistent output, optional but good for readability
@@ -452,15 +952,15 @@ void displayMap(const AdjacencyMap& map) {
                 return a.second.second < b.second.second;
             });
             for (auto& p : sorted_edges) {
-                cout << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
+                out << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
             }
         }
-        cout << "\n";
+        out << "\n";
     }
 
-    cout << "Incoming mappings:\n";
+    out << "Incoming mappings:\n";
     for (int i = 0; i < map.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         auto it = map.incoming.find(i);
         if (it != map.incoming.end()) {
             // Sorting for consistent output, optional but good for readability
@@ -471,10 +971,69 @@ void displayMap(const AdjacencyMap& map) {
                 return a.second.second < b.second.second;
             });
             for (auto& p : sorted_edges) {
-                cout << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
+                out << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
             }
         }
-        cout << "\n";
+        out << "\n";
+    }
+}
+
+// View display functions, same output format as the ones above.
+void displayList(const AdjacencyListView& list, ostream& out = cout) {
+    out << "Adjacency List:\n";
+    for (int i = 0; i < list.n; i++) {
+        out << i << ": ";
+        for (int k = 0; k < list.degree(i); k++) {
+            out << list.neighbor(i, k) << " ";
+        }
+        out << "\n";
+    }
+}
+
+void displayExtended(const ExtendedAdjacencyListView& ext, ostream& out = cout) {
+    out << "Extended Adjacency List:\n";
+    out << "Total Edges (m): " << ext.m << "\n";
+    out << "Edges (u,v) and their indices:\n";
+    const auto& edges = ext.edges();
+    for (int i = 0; i < (int)edges.size(); i++) {
+        out << "  Edge " << i << ": (" << edges[i].first << "," << edges[i].second << ")\n";
+    }
+
+    out << "Outgoing edges (indices):\n";
+    for (int i = 0; i < ext.n; i++) {
+        out << i << ": ";
+        for (int k = 0; k < ext.degree(i); k++) {
+            out << ext.incidentEdge(i, k) << " ";
+        }
+        out << "\n";
+    }
+
+    out << "Incoming edges (indices):\n";
+    for (int i = 0; i < ext.n; i++) {
+        out << i << ": ";
+        for (int k = 0; k < ext.degree(i); k++) {
+            out << ext.incidentEdge(i, k) << " ";
+        }
+        out << "\n";
+    }
+}
+
+void displayMap(const AdjacencyMapView& map, ostream& out = cout) {
+    out << "Adjacency Map:\n";
+    out << "Total Edges (m): " << map.m << "\n";
+    // Since the store is sorted canonically, the entries of a vertex already come out
+    // ordered by neighbor, so no per-vertex sort is needed here.
+    const char* titles[2] = {"Outgoing mappings:\n", "Incoming mappings:\n"};
+    for (const char* title : titles) {
+        out << title;
+        for (int i = 0; i < map.n; i++) {
+            out << i << ": ";
+            for (int k = 0; k < map.degree(i); k++) {
+                auto p = map.entry(i, k);
+                out << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
+            }
+            out << "\n";
+        }
     }
 }
 
@@ -549,7 +1108,244 @@ string getRepName(Representation rep) {
     }
 }
 
-int main() {
+// ========== MEMORY FOOTPRINT ==========
+// Exact number of bytes each representation occupies: the struct itself plus all the heap
+// memory it owns, including container overhead, hash buckets and unused vector capacity
+// (see common/footprint.h).
+
+size_t footprintBytes(const AdjacencyList& list) {
+    return sizeof(list) + heapBytes(list.adj);
+}
+
+size_t footprintBytes(const AdjacencyMatrix& matrix) {
+    return sizeof(matrix) + heapBytes(matrix.matrix);
+}
+
+size_t footprintBytes(const ExtendedAdjacencyList& ext) {
+    return sizeof(ext) + heapBytes(ext.incoming) + heapBytes(ext.outgoing) + heapBytes(ext.edges);
+}
+
+size_t footprintBytes(const AdjacencyMap& map) {
+    return sizeof(map) + heapBytes(map.incoming) + heapBytes(map.outgoing);
+}
+
+// The canonical store owns the graph for all three views; a view itself is just a pointer.
+size_t footprintBytes(const EdgeStore& store) {
+    return sizeof(store) + heapBytes(store.edges) + heapBytes(store.offset) + heapBytes(store.incident);
+}
+
+// ========== FINGERPRINTS ==========
+// Order-independent fingerprint of the graph each representation holds (see
+// common/graph_fingerprint.h), computed from what the representation stores so that two
+// representations of the same graph compare equal without sorting or printing them.
+
+GraphFingerprint fingerprintOf(const AdjacencyList& list) {
+    GraphFingerprint f;
+    for (int u = 0; u < list.n; u++) {
+        for (int v : list.adj[u]) f.addArc(u, v);
+    }
+    return f;
+}
+
+GraphFingerprint fingerprintOf(const AdjacencyMatrix& matrix) {
+    GraphFingerprint f;
+    for (int i = 0; i < matrix.n; i++) {
+        for (int j = 0; j < matrix.n; j++) {
+            if (matrix.matrix[i][j]) f.addArc(i, j, matrix.matrix[i][j]);
+        }
+    }
+    return f;
+}
+
+// Follows the outgoing incidence lists, so the edge ids and the edges they point to are both checked.
+GraphFingerprint fingerprintOf(const ExtendedAdjacencyList& ext) {
+    GraphFingerprint f;
+    for (int u = 0; u < ext.n; u++) {
+        for (int edge_idx : ext.outgoing[u]) {
+            const pair<int, int>& e = ext.edges[edge_idx];
+            f.addArc(u, e.first == u ? e.second : e.first);
+        }
+    }
+    return f;
+}
+
+GraphFingerprint fingerprintOf(const AdjacencyMap& map) {
+    GraphFingerprint f;
+    for (const auto& vertex_pair : map.outgoing) {
+        for (const auto& edge_info : vertex_pair.second) f.addArc(vertex_pair.first, edge_info.first);
+    }
+    return f;
+}
+
+// The edge store behind the interactive views holds every edge once.
+GraphFingerprint fingerprintOf(const EdgeStore& store) {
+    GraphFingerprint f;
+    for (const auto& e : store.edges) f.addEdge(e.first, e.second);
+    return f;
+}
+
+// ========== TRIANGLES ==========
+// Triangle counts and clustering coefficients of the graph in any representation (see
+// common/triangles.h); each representation only lists the neighbors of a vertex, with
+// their multiplicities, and the engine does the rest in parallel.
+
+TriangleStats trianglesOf(const AdjacencyList& list) {
+    return count_triangles(list.n, [&](int u, auto visit) {
+        for (int v : list.adj[u]) visit(v, 1);
+    }, conversionThreadCount(list.n));
+}
+
+TriangleStats trianglesOf(const AdjacencyMatrix& matrix) {
+    return count_triangles(matrix.n, [&](int u, auto visit) {
+        for (int v = 0; v < matrix.n; v++) {
+            if (matrix.matrix[u][v] > 0) visit(v, matrix.matrix[u][v]);
+        }
+    }, conversionThreadCount(matrix.n));
+}
+
+TriangleStats trianglesOf(const ExtendedAdjacencyList& ext) {
+    return count_triangles(ext.n, [&](int u, auto visit) {
+        for (int edge_idx : ext.outgoing[u]) {
+            const pair<int, int>& e = ext.edges[edge_idx];
+            visit(e.first == u ? e.second : e.first, 1);
+        }
+    }, conversionThreadCount(ext.n));
+}
+
+TriangleStats trianglesOf(const AdjacencyMap& map) {
+    return count_triangles(map.n, [&](int u, auto visit) {
+        auto it = map.outgoing.find(u);
+        if (it == map.outgoing.end()) return;
+        for (const auto& edge_info : it->second) visit(edge_info.first, 1);
+    }, conversionThreadCount(map.n));
+}
+
+// ========== BATCH MODE ==========
+// --batch, shared with the other represent tools by common/represent_batch.h. A loop is
+// listed once in the adjacency lists, as the conversions expect, and --threads N runs the
+// parallel conversion kernels with conversion_threads = N (0: all hardware threads).
+
+struct GeneralBatchTool : RepresentBatchTool {
+    using Rep = Representation;
+    using List = AdjacencyList;
+    using Matrix = AdjacencyMatrix;
+    using Extended = ExtendedAdjacencyList;
+    using Map = AdjacencyMap;
+    static constexpr const char* graph_kind = "do thi tong quat";
+    static constexpr bool loops_listed_once = true;
+    static constexpr bool has_threads_option = true;
+
+    // The interactive menu keeps a single edge store behind its views instead
+    static void print_extra_footprint(const AdjacencyList& list) {
+        EdgeStore store = makeEdgeStore(list.n, listToExtended(list).edges);
+        store.ensureIndex();
+        cerr << "  " << left << setw(32) << "Edge store (+ 3 views)" << right << setw(14) << footprintBytes(store) << " bytes\n";
+    }
+
+    static void set_threads(int threads) { conversion_threads = threads; }
+
+    // Applies one of the 12 conversions in place with the parallel kernels.
+    static void convert_parallel(RepresentBatchGraph<GeneralBatchTool>& g, Representation to) {
+        if (g.rep == to) return;
+        switch (g.rep) {
+            case ADJ_LIST:
+                if (to == ADJ_MATRIX) g.matrix = listToMatrixParallel(g.list);
+                else if (to == EXT_ADJ_LIST) g.extended = listToExtendedParallel(g.list);
+                else g.map = listToMapParallel(g.list);
+                g.list = AdjacencyList();
+                break;
+            case ADJ_MATRIX:
+                if (to == ADJ_LIST) g.list = matrixToListParallel(g.matrix);
+                else if (to == EXT_ADJ_LIST) g.extended = matrixToExtendedParallel(g.matrix);
+                else g.map = matrixToMapParallel(g.matrix);
+                g.matrix = AdjacencyMatrix();
+                break;
+            case EXT_ADJ_LIST:
+                if (to == ADJ_LIST) g.list = extendedToListParallel(g.extended);
+                else if (to == ADJ_MATRIX) g.matrix = extendedToMatrixParallel(g.extended);
+                else g.map = extendedToMapParallel(g.extended);
+                g.extended = ExtendedAdjacencyList();
+                break;
+            case ADJ_MAP:
+                if (to == ADJ_LIST) g.list = mapToListParallel(g.map);
+                else if (to == ADJ_MATRIX) g.matrix = mapToMatrixParallel(g.map);
+                else g.extended = mapToExtendedParallel(g.map);
+                g.map = AdjacencyMap();
+                break;
+        }
+        g.rep = to;
+    }
+};
+
+// ========== BENCHMARK MODE ==========
+// Usage: represent_general --bench [n1,n2,...] [d1,d2,...]
+// Generates random general graphs for every (n, density) pair of the grid, runs each of the
+// conversions on it through run_bench_grid of conversion_bench.h and prints one CSV line per
+// conversion.
+// Density is the number of edges per vertex pair, m = density * n(n+1)/2.
+
+// Random general graph with density * n(n+1)/2 edges between uniformly chosen endpoints,
+// so loops and repeated edges both occur.
+AdjacencyList generateBenchGraph(int n, double density, mt19937& rng, long long& m) {
+    AdjacencyList list;
+    list.n = n;
+    list.adj.assign(n, vector<int>());
+    m = n > 0 ? llround(density * n * (n + 1) / 2.0) : 0;
+    uniform_int_distribution<int> vertex(0, max(0, n - 1));
+    for (long long i = 0; i < m; i++) {
+        int u = vertex(rng), v = vertex(rng);
+        list.adj[u].push_back(v);
+        if (u != v) list.adj[v].push_back(u); // Same as the input, a loop appears once in adj[u]
+    }
+    return list;
+}
+
+int runBench(int argc, char* argv[]) {
+    return run_bench_grid(argc, argv, "general", generateBenchGraph, [](const BenchCase& bench, const AdjacencyList& list) {
+        AdjacencyMatrix matrix = listToMatrix(list);
+        ExtendedAdjacencyList ext = listToExtended(list);
+        AdjacencyMap map = listToMap(list);
+
+        bench_conversion(bench, "listToMatrix", list, listToMatrix);
+        bench_conversion(bench, "listToExtended", list, listToExtended);
+        bench_conversion(bench, "listToMap", list, listToMap);
+        bench_conversion(bench, "matrixToList", matrix, matrixToList);
+        bench_conversion(bench, "matrixToExtended", matrix, matrixToExtended);
+        bench_conversion(bench, "matrixToMap", matrix, matrixToMap);
+        bench_conversion(bench, "extendedToList", ext, extendedToList);
+        bench_conversion(bench, "extendedToMatrix", ext, extendedToMatrix);
+        bench_conversion(bench, "extendedToMap", ext, extendedToMap);
+        bench_conversion(bench, "mapToList", map, mapToList);
+        bench_conversion(bench, "mapToMatrix", map, mapToMatrix);
+        bench_conversion(bench, "mapToExtended", map, mapToExtended);
+
+        // The parallel kernels, with conversion_threads threads
+        bench_conversion(bench, "listToMatrixParallel", list, listToMatrixParallel);
+        bench_conversion(bench, "listToExtendedParallel", list, listToExtendedParallel);
+        bench_conversion(bench, "edgesToInputOrderEAL", ext.edges, [&bench](const vector<pair<int, int>>& edges) {
+            return edgesToInputOrderEAL(bench.n, edges);
+        });
+        bench_conversion(bench, "listToMapParallel", list, listToMapParallel);
+        bench_conversion(bench, "matrixToListParallel", matrix, matrixToListParallel);
+        bench_conversion(bench, "matrixToExtendedParallel", matrix, matrixToExtendedParallel);
+        bench_conversion(bench, "matrixToMapParallel", matrix, matrixToMapParallel);
+        bench_conversion(bench, "extendedToListParallel", ext, extendedToListParallel);
+        bench_conversion(bench, "extendedToMatrixParallel", ext, extendedToMatrixParallel);
+        bench_conversion(bench, "extendedToMapParallel", ext, extendedToMapParallel);
+        bench_conversion(bench, "mapToListParallel", map, mapToListParallel);
+        bench_conversion(bench, "mapToMatrixParallel", map, mapToMatrixParallel);
+        bench_conversion(bench, "mapToExtendedParallel", map, mapToExtendedParallel);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        return run_represent_batch<GeneralBatchTool>(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        return runBench(argc, argv);
+    }
+
     cout << "=== CHUONG TRINH CHUYEN DOI BIEU DIEN DO THI TONG QUAT (CHO PHEP DA CANH VA KHUYEN) ===\n\n";
 
     int n;
@@ -557,8 +1353,8 @@ int main() {
     cout << "Nhap so dinh va so canh: ";
     cin >> n >> m_input;
 
-    current_list.n = n;
-    current_list.adj.resize(n);
+    vector<pair<int, int>> input_edges;
+    input_edges.reserve(m_input);
 
     cout << "Nhap " << m_input << " canh (dinh dau dinh cuoi):\n";
     for (int i = 0; i < m_input; i++) {
@@ -570,10 +1366,16 @@ int main() {
             continue;
         }
         // Removed the check for u == v, as loops are now allowed
-        current_list.adj[u].push_back(v);
-        current_list.adj[v].push_back(u); // Undirected graph
+        input_edges.push_back({u, v}); // Undirected graph, stored once
+        // A loop goes in twice, as the adjacency list always had it (u appended to adj[u] from
+        // both ends): it shows twice in the lists and counts 2 on the matrix diagonal
+        if (u == v) input_edges.push_back({u, v});
     }
 
+    // The edge set never changes, only the way it is viewed
+    current_store = makeEdgeStore(n, std::move(input_edges));
+    current_list = makeListView(current_store);
+
     while (true) {
         cout << "\n=== MENU CHUYEN DOI ===\n";
         cout << "1. Hien thi do thi hien tai\n";
@@ -611,84 +1413,87 @@ int main() {
                 displayCurrentRepresentation();
                 break;
             case 2: {
-                current_matrix = listToMatrix(current_list);
+                current_matrix = storeToMatrix(current_store);
                 current_rep = ADJ_MATRIX;
                 cout << "\nDa chuyen doi thanh cong: Adjacency List -> Adjacency Matrix\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 3: {
-                current_extended = listToExtended(current_list);
+                current_extended = makeExtendedView(current_store);
                 current_rep = EXT_ADJ_LIST;
                 cout << "\nDa chuyen doi thanh cong: Adjacency List -> Extended Adjacency List\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 4: {
-                current_map = listToMap(current_list);
+                current_map = makeMapView(current_store);
                 current_rep = ADJ_MAP;
                 cout << "\nDa chuyen doi thanh cong: Adjacency List -> Adjacency Map\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 5: {
-                current_list = matrixToList(current_matrix);
+                current_list = makeListView(current_store);
+                current_matrix = AdjacencyMatrix(); // The store already holds the same edges
                 current_rep = ADJ_LIST;
                 cout << "\nDa chuyen doi thanh cong: Adjacency Matrix -> Adjacency List\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 6: {
-                current_extended = matrixToExtended(current_matrix);
+                current_extended = makeExtendedView(current_store);
+                current_matrix = AdjacencyMatrix();
                 current_rep = EXT_ADJ_LIST;
                 cout << "\nDa chuyen doi thanh cong: Adjacency Matrix -> Extended Adjacency List\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 7: {
-                current_map = matrixToMap(current_matrix);
+                current_map = makeMapView(current_store);
+                current_matrix = AdjacencyMatrix();
                 current_rep = ADJ_MAP;
                 cout << "\nDa chuyen doi thanh cong: Adjacency Matrix -> Adjacency Map\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 8: {
-                current_list = extendedToList(current_extended);
+                current_list = makeListView(current_store);
                 current_rep = ADJ_LIST;
                 cout << "\nDa chuyen doi thanh cong: Extended Adjacency List -> Adjacency List\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 9: {
-                current_matrix = extendedToMatrix(current_extended);
+                current_matrix = storeToMatrix(current_store);
                 current_rep = ADJ_MATRIX;
                 cout << "\nDa chuyen doi thanh cong: Extended Adjacency List -> Adjacency Matrix\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 10: {
-                current_map = extendedToMap(current_extended);
+                current_map = makeMapView(current_store);
                 current_rep = ADJ_MAP;
                 cout << "\nDa chuyen doi thanh cong: Extended Adjacency List -> Adjacency Map\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 11: {
-                current_list = mapToList(current_map);
+                current_list = makeListView(current_store);
                 current_rep = ADJ_LIST;
                 cout << "\nDa chuyen doi thanh cong: Adjacency Map -> Adjacency List\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 12: {
-                current_matrix = mapToMatrix(current_map);
+                current_matrix = storeToMatrix(current_store);
                 current_rep = ADJ_MATRIX;
                 cout << "\nDa chuyen doi thanh cong: Adjacency Map -> Adjacency Matrix\n";
                 displayCurrentRepresentation();
                 break;
             }
             case 13: {
-                current_extended = mapToExtended(current_map);
+                current_extended = makeExtendedView(current_store);
                 current_rep = EXT_ADJ_LIST;
                 cout << "\nDa chuyen doi thanh cong: Adjacency Map -> Extended Adjacency List\n";
                 displayCurrentRepresentation();
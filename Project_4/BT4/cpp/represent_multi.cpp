@@ -5,13 +5,87 @@
 #include <string>
 #include <set> // Still useful for mapToExtended to collect unique edges before expanding
 #include <algorithm> // For std::min and std::max
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <cstdint>
+#ifdef __SSE2__
+#include <emmintrin.h> // SSE2 row scans of the multiplicity matrix
+#endif
+
+#include "../../../common/graph_loader.h" // Graph files in every format (.inp, DIMACS, SGB, .bin, .nga)
+#include "../../../common/footprint.h"    // Heap footprint of the representations
+#include "../../../common/graph_fingerprint.h" // Round-trip checks in batch mode
+#include "../../../common/triangles.h"         // Triangle counts and clustering coefficients
+#include "../../../common/conversion_bench.h"  // --bench grid and heap counters
+#include "../../../common/represent_batch.h"    // --batch driver shared by the represent tools
 
 using namespace std;
 
 // Graph representations
+// Stores count of edges between vertices, one byte per cell, row-major in a single array.
+// Multiplicities are almost always below 255, so this is a quarter of an int matrix; a cell
+// holding OVERFLOW_MARK keeps its real count (255 or more) in the overflow table.
 struct AdjacencyMatrix {
-    vector<vector<int>> matrix; // Stores count of edges between vertices
+    static const uint8_t OVERFLOW_MARK = 255;
+    vector<uint8_t> cells;                  // cells[i * n + j]
+    unordered_map<long long, int> overflow; // i * n + j -> count, for cells holding OVERFLOW_MARK
     int n;
+
+    // Sets the matrix to n x n zeros.
+    void reset(int size) {
+        n = size;
+        cells.assign((size_t)n * n, 0);
+        overflow.clear();
+    }
+
+    int count(int i, int j) const {
+        size_t k = (size_t)i * n + j;
+        return cells[k] == OVERFLOW_MARK ? overflow.at((long long)k) : cells[k];
+    }
+
+    // Adds one edge instance to cell (i, j).
+    void increment(int i, int j) {
+        size_t k = (size_t)i * n + j;
+        if (cells[k] < OVERFLOW_MARK - 1) {
+            cells[k]++;
+        } else if (cells[k] == OVERFLOW_MARK - 1) {
+            cells[k] = OVERFLOW_MARK;
+            overflow[(long long)k] = OVERFLOW_MARK;
+        } else {
+            overflow[(long long)k]++;
+        }
+    }
+
+    // Calls visit(j, count) for every non-zero cell (i, j) with j >= from, in increasing j.
+    // With SSE2 the zero cells are skipped 16 at a time.
+    template <typename Visit>
+    void forEachInRow(int i, int from, Visit visit) const {
+        const uint8_t* row = cells.data() + (size_t)i * n;
+        auto emit = [&](int j) {
+            visit(j, row[j] == OVERFLOW_MARK ? overflow.at((long long)i * n + j) : (int)row[j]);
+        };
+        int j = from;
+#ifdef __SSE2__
+        const __m128i zero = _mm_setzero_si128();
+        for (; j + 16 <= n; j += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(row + j));
+            unsigned mask = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)) & 0xFFFFu;
+            while (mask != 0) {
+                emit(j + __builtin_ctz(mask));
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; j < n; j++) {
+            if (row[j] != 0) emit(j);
+        }
+    }
 };
 
 struct AdjacencyList {
@@ -57,8 +131,7 @@ Representation current_rep = ADJ_LIST;
 // For multigraphs, the matrix cells store the count of edges between vertices.
 AdjacencyMatrix listToMatrix(const AdjacencyList& list) {
     AdjacencyMatrix matrix;
-    matrix.n = list.n;
-    matrix.matrix.resize(matrix.n, vector<int>(matrix.n, 0)); // Initialize with 0
+    matrix.reset(list.n); // Initialize with 0
 
     // Iterate through each vertex's adjacency list
     for (int i = 0; i < list.n; i++) {
@@ -68,7 +141,7 @@ AdjacencyMatrix listToMatrix(const AdjacencyList& list) {
             // matrix[i][j] will be incremented when processing adj[i], and matrix[j][i]
             // will be incremented when processing adj[j]. This naturally maintains symmetry
             // and counts for multigraphs.
-            matrix.matrix[i][j]++;
+            matrix.increment(i, j);
         }
     }
     return matrix;
@@ -81,14 +154,12 @@ AdjacencyList matrixToList(const AdjacencyMatrix& matrix) {
     list.n = matrix.n;
     list.adj.resize(list.n);
 
-    // Iterate through all cells of the matrix
+    // Scan every row for its non-zero cells
     for (int i = 0; i < matrix.n; i++) {
-        for (int j = 0; j < matrix.n; j++) {
-            // Add 'j' to 'i's list 'matrix.matrix[i][j]' times
-            for (int k = 0; k < matrix.matrix[i][j]; k++) {
-                list.adj[i].push_back(j);
-            }
-        }
+        matrix.forEachInRow(i, 0, [&](int j, int edge_count) {
+            // Add 'j' to 'i's list 'edge_count' times
+            list.adj[i].insert(list.adj[i].end(), edge_count, j);
+        });
     }
     return list;
 }
@@ -105,28 +176,25 @@ ExtendedAdjacencyList matrixToExtended(const AdjacencyMatrix& matrix) {
 
     // Collect all edge instances
     for (int i = 0; i < matrix.n; i++) {
-        for (int j = 0; j < matrix.n; j++) {
-            // For undirected multigraphs, we only process (i,j) where i <= j
-            // to avoid double-counting the same undirected edge instance when adding to ext.edges.
-            if (i <= j) {
-                int edge_count = matrix.matrix[i][j];
-                for (int k = 0; k < edge_count; k++) {
-                    ext.edges.push_back({i, j}); // Add the edge instance
-                    int edge_idx = ext.edges.size() - 1; // Index of the newly added edge
-
-                    ext.outgoing[i].push_back(edge_idx);
-                    ext.incoming[j].push_back(edge_idx);
-
-                    if (i != j) { // If not a self-loop (disallowed for multigraphs)
-                        // For undirected graph, (j,i) also exists, and its incoming/outgoing
-                        // lists should point to the same edge index.
-                        ext.outgoing[j].push_back(edge_idx);
-                        ext.incoming[i].push_back(edge_idx);
-                    }
-                    ext.m++; // Increment total edge count for each instance
+        // For undirected multigraphs, we only process (i,j) where i <= j
+        // to avoid double-counting the same undirected edge instance when adding to ext.edges.
+        matrix.forEachInRow(i, i, [&](int j, int edge_count) {
+            for (int k = 0; k < edge_count; k++) {
+                ext.edges.push_back({i, j}); // Add the edge instance
+                int edge_idx = ext.edges.size() - 1; // Index of the newly added edge
+
+                ext.outgoing[i].push_back(edge_idx);
+                ext.incoming[j].push_back(edge_idx);
+
+                if (i != j) { // If not a self-loop (disallowed for multigraphs)
+                    // For undirected graph, (j,i) also exists, and its incoming/outgoing
+                    // lists should point to the same edge index.
+                    ext.outgoing[j].push_back(edge_idx);
+                    ext.incoming[i].push_back(edge_idx);
                 }
+                ext.m++; // Increment total edge count for each instance
             }
-        }
+        });
     }
     return ext;
 }
@@ -135,16 +203,15 @@ ExtendedAdjacencyList matrixToExtended(const AdjacencyMatrix& matrix) {
 // Each edge in ext.edges increments the corresponding matrix cell.
 AdjacencyMatrix extendedToMatrix(const ExtendedAdjacencyList& ext) {
     AdjacencyMatrix matrix;
-    matrix.n = ext.n;
-    matrix.matrix.resize(matrix.n, vector<int>(matrix.n, 0)); // Initialize with 0
+    matrix.reset(ext.n); // Initialize with 0
 
     // Iterate through all individual edge instances
     for (const auto& edge : ext.edges) {
         int u = edge.first;
         int v = edge.second;
-        matrix.matrix[u][v]++;
+        matrix.increment(u, v);
         if (u != v) { // For undirected graph, also increment the reverse
-            matrix.matrix[v][u]++;
+            matrix.increment(v, u);
         }
     }
     return matrix;
@@ -159,16 +226,13 @@ AdjacencyMap matrixToMap(const AdjacencyMatrix& matrix) {
     map.m = 0; // Initialize total edge count
 
     for (int i = 0; i < matrix.n; i++) {
-        for (int j = 0; j < matrix.n; j++) {
-            int edge_count = matrix.matrix[i][j];
-            if (edge_count > 0) {
-                pair<int, int> canonical_edge = {min(i, j), max(i, j)};
-                for (int k = 0; k < edge_count; ++k) {
-                    map.outgoing[i].push_back({j, canonical_edge});
-                    map.incoming[j].push_back({i, canonical_edge}); // For undirected graph
-                }
+        matrix.forEachInRow(i, 0, [&](int j, int edge_count) {
+            pair<int, int> canonical_edge = {min(i, j), max(i, j)};
+            for (int k = 0; k < edge_count; ++k) {
+                map.outgoing[i].push_back({j, canonical_edge});
+                map.incoming[j].push_back({i, canonical_edge}); // For undirected graph
             }
-        }
+        });
     }
     // Count m: Sum up the sizes of all vectors in outgoing and divide by 2
     for (const auto& entry : map.outgoing) {
@@ -182,15 +246,14 @@ AdjacencyMap matrixToMap(const AdjacencyMatrix& matrix) {
 // The matrix cells are populated with counts based on the map's stored edge instances.
 AdjacencyMatrix mapToMatrix(const AdjacencyMap& map) {
     AdjacencyMatrix matrix;
-    matrix.n = map.n;
-    matrix.matrix.resize(matrix.n, vector<int>(matrix.n, 0));
+    matrix.reset(map.n);
 
     // Iterate through outgoing mappings
     for (const auto& vertex_pair : map.outgoing) {
         int u = vertex_pair.first;
         for (const auto& edge_info : vertex_pair.second) {
             int v = edge_info.first;
-            matrix.matrix[u][v]++;
+            matrix.increment(u, v);
         }
     }
     return matrix;
@@ -322,6 +385,10 @@ AdjacencyMap extendedToMap(const ExtendedAdjacencyList& ext) {
 
         map.outgoing[u].push_back({v, canonical_edge});
         map.incoming[v].push_back({u, canonical_edge}); // For undirected graph
+        if (u != v) { // The reverse connection, as listToMap has it; mapToExtended relies on it
+            map.outgoing[v].push_back({u, canonical_edge});
+            map.incoming[u].push_back({v, canonical_edge});
+        }
     }
     return map;
 }
@@ -370,67 +437,67 @@ ExtendedAdjacencyList mapToExtended(const AdjacencyMap& map) {
 }
 
 // Display functions
-void displayMatrix(const AdjacencyMatrix& matrix) {
-    cout << "Adjacency Matrix:\n";
-    cout << "   ";
+void displayMatrix(const AdjacencyMatrix& matrix, ostream& out = cout) {
+    out << "Adjacency Matrix:\n";
+    out << "   ";
     for (int i = 0; i < matrix.n; i++) {
-        cout << i << " ";
+        out << i << " ";
     }
-    cout << "\n";
+    out << "\n";
 
     for (int i = 0; i < matrix.n; i++) {
-        cout << i << "  ";
+        out << i << "  ";
         for (int j = 0; j < matrix.n; j++) {
-            cout << matrix.matrix[i][j] << " ";
+            out << matrix.count(i, j) << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayList(const AdjacencyList& list) {
-    cout << "Adjacency List:\n";
+void displayList(const AdjacencyList& list, ostream& out = cout) {
+    out << "Adjacency List:\n";
     for (int i = 0; i < list.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int j : list.adj[i]) {
-            cout << j << " ";
+            out << j << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayExtended(const ExtendedAdjacencyList& ext) {
-    cout << "Extended Adjacency List:\n";
-    cout << "Total Edges (m): " << ext.m << "\n";
-    cout << "Edges (u,v) and their indices:\n";
+void displayExtended(const ExtendedAdjacencyList& ext, ostream& out = cout) {
+    out << "Extended Adjacency List:\n";
+    out << "Total Edges (m): " << ext.m << "\n";
+    out << "Edges (u,v) and their indices:\n";
     for (int i = 0; i < ext.edges.size(); i++) {
-        cout << "  Edge " << i << ": (" << ext.edges[i].first << "," << ext.edges[i].second << ")\n";
+        out << "  Edge " << i << ": (" << ext.edges[i].first << "," << ext.edges[i].second << ")\n";
     }
 
-    cout << "Outgoing edges (indices):\n";
+    out << "Outgoing edges (indices):\n";
     for (int i = 0; i < ext.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int edge_idx : ext.outgoing[i]) {
-            cout << edge_idx << " ";
+            out << edge_idx << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 
-    cout << "Incoming edges (indices):\n";
+    out << "Incoming edges (indices):\n";
     for (int i = 0; i < ext.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int edge_idx : ext.incoming[i]) {
-            cout << edge_idx << " ";
+            out << edge_idx << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayMap(const AdjacencyMap& map) {
-    cout << "Adjacency Map:\n";
-    cout << "Total Edges (m): " << map.m << "\n";
-    cout << "Outgoing mappings (neighbor -> canonical_edge):\n";
+void displayMap(const AdjacencyMap& map, ostream& out = cout) {
+    out << "Adjacency Map:\n";
+    out << "Total Edges (m): " << map.m << "\n";
+    out << "Outgoing mappings (neighbor -> canonical_edge):\n";
     for (int i = 0; i < map.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         auto it = map.outgoing.find(i);
         if (it != map.outgoing.end()) {
             // Sort the vector for consistent output, if desired (optional)
@@ -440,15 +507,15 @@ void displayMap(const AdjacencyMap& map) {
             //     return a.second.second < b.second.second;
             // });
             for (auto& p : it->second) {
-                cout << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
+                out << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
             }
         }
-        cout << "\n";
+        out << "\n";
     }
 
-    cout << "Incoming mappings (neighbor -> canonical_edge):\n";
+    out << "Incoming mappings (neighbor -> canonical_edge):\n";
     for (int i = 0; i < map.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         auto it = map.incoming.find(i);
         if (it != map.incoming.end()) {
             // Sort the vector for consistent output, if desired (optional)
@@ -458,10 +525,10 @@ void displayMap(const AdjacencyMap& map) {
             //     return a.second.second < b.second.second;
             // });
             for (auto& p : it->second) {
-                cout << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
+                out << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
             }
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
@@ -536,7 +603,173 @@ string getRepName(Representation rep) {
     }
 }
 
-int main() {
+// ========== MEMORY FOOTPRINT ==========
+// Exact number of bytes each representation occupies: the struct itself plus all the heap
+// memory it owns, including container overhead, hash buckets and unused vector capacity
+// (see common/footprint.h).
+
+size_t footprintBytes(const AdjacencyList& list) {
+    return sizeof(list) + heapBytes(list.adj);
+}
+
+size_t footprintBytes(const AdjacencyMatrix& matrix) {
+    return sizeof(matrix) + heapBytes(matrix.cells) + heapBytes(matrix.overflow);
+}
+
+size_t footprintBytes(const ExtendedAdjacencyList& ext) {
+    return sizeof(ext) + heapBytes(ext.incoming) + heapBytes(ext.outgoing) + heapBytes(ext.edges);
+}
+
+size_t footprintBytes(const AdjacencyMap& map) {
+    return sizeof(map) + heapBytes(map.incoming) + heapBytes(map.outgoing);
+}
+
+// ========== FINGERPRINTS ==========
+// Order-independent fingerprint of the graph each representation holds (see
+// common/graph_fingerprint.h), computed from what the representation stores so that two
+// representations of the same graph compare equal without sorting or printing them.
+
+GraphFingerprint fingerprintOf(const AdjacencyList& list) {
+    GraphFingerprint f;
+    for (int u = 0; u < list.n; u++) {
+        for (int v : list.adj[u]) f.addArc(u, v);
+    }
+    return f;
+}
+
+GraphFingerprint fingerprintOf(const AdjacencyMatrix& matrix) {
+    GraphFingerprint f;
+    for (int i = 0; i < matrix.n; i++) {
+        matrix.forEachInRow(i, 0, [&](int j, int edge_count) { f.addArc(i, j, edge_count); });
+    }
+    return f;
+}
+
+// Follows the outgoing incidence lists, so the edge ids and the edges they point to are both checked.
+GraphFingerprint fingerprintOf(const ExtendedAdjacencyList& ext) {
+    GraphFingerprint f;
+    for (int u = 0; u < ext.n; u++) {
+        for (int edge_idx : ext.outgoing[u]) {
+            const pair<int, int>& e = ext.edges[edge_idx];
+            f.addArc(u, e.first == u ? e.second : e.first);
+        }
+    }
+    return f;
+}
+
+GraphFingerprint fingerprintOf(const AdjacencyMap& map) {
+    GraphFingerprint f;
+    for (const auto& vertex_pair : map.outgoing) {
+        for (const auto& edge_info : vertex_pair.second) f.addArc(vertex_pair.first, edge_info.first);
+    }
+    return f;
+}
+
+// ========== TRIANGLES ==========
+// Triangle counts and clustering coefficients of the graph in any representation (see
+// common/triangles.h); each representation only lists the neighbors of a vertex, with
+// their multiplicities, and the engine does the rest in parallel.
+
+TriangleStats trianglesOf(const AdjacencyList& list) {
+    return count_triangles(list.n, [&](int u, auto visit) {
+        for (int v : list.adj[u]) visit(v, 1);
+    }, (int)thread::hardware_concurrency());
+}
+
+TriangleStats trianglesOf(const AdjacencyMatrix& matrix) {
+    return count_triangles(matrix.n, [&](int u, auto visit) {
+        matrix.forEachInRow(u, 0, [&](int v, int edge_count) { visit(v, edge_count); });
+    }, (int)thread::hardware_concurrency());
+}
+
+TriangleStats trianglesOf(const ExtendedAdjacencyList& ext) {
+    return count_triangles(ext.n, [&](int u, auto visit) {
+        for (int edge_idx : ext.outgoing[u]) {
+            const pair<int, int>& e = ext.edges[edge_idx];
+            visit(e.first == u ? e.second : e.first, 1);
+        }
+    }, (int)thread::hardware_concurrency());
+}
+
+TriangleStats trianglesOf(const AdjacencyMap& map) {
+    return count_triangles(map.n, [&](int u, auto visit) {
+        auto it = map.outgoing.find(u);
+        if (it == map.outgoing.end()) return;
+        for (const auto& edge_info : it->second) visit(edge_info.first, 1);
+    }, (int)thread::hardware_concurrency());
+}
+
+// ========== BATCH MODE ==========
+// --batch, shared with the other represent tools by common/represent_batch.h; a multigraph
+// file must not contain loops.
+
+struct MultiBatchTool : RepresentBatchTool {
+    using Rep = Representation;
+    using List = AdjacencyList;
+    using Matrix = AdjacencyMatrix;
+    using Extended = ExtendedAdjacencyList;
+    using Map = AdjacencyMap;
+    static constexpr const char* graph_kind = "da do thi";
+
+    static bool check_edge(int u, int v) {
+        if (u != v) return true;
+        cerr << "Loi: Canh (" << u << "," << v << ") la mot khuyen. Do thi da bo khong cho phep khuyen\n";
+        return false;
+    }
+};
+
+// ========== BENCHMARK MODE ==========
+// Usage: represent_multi --bench [n1,n2,...] [d1,d2,...]
+// Generates random multigraphs for every (n, density) pair of the grid, runs each of the
+// conversions on it through run_bench_grid of conversion_bench.h and prints one CSV line per
+// conversion.
+// Density is the number of edges per vertex pair, m = density * n(n-1)/2.
+
+// Random multigraph with density * n(n-1)/2 edges between uniformly chosen distinct endpoints.
+AdjacencyList generateBenchGraph(int n, double density, mt19937& rng, long long& m) {
+    AdjacencyList list;
+    list.n = n;
+    list.adj.assign(n, vector<int>());
+    m = n > 1 ? llround(density * n * (n - 1) / 2.0) : 0;
+    uniform_int_distribution<int> vertex(0, max(0, n - 1));
+    for (long long i = 0; i < m; i++) {
+        int u = vertex(rng), v = vertex(rng);
+        while (v == u) v = vertex(rng); // No loops in a multigraph
+        list.adj[u].push_back(v);
+        list.adj[v].push_back(u);
+    }
+    return list;
+}
+
+int runBench(int argc, char* argv[]) {
+    return run_bench_grid(argc, argv, "multi", generateBenchGraph, [](const BenchCase& bench, const AdjacencyList& list) {
+        AdjacencyMatrix matrix = listToMatrix(list);
+        ExtendedAdjacencyList ext = listToExtended(list);
+        AdjacencyMap map = listToMap(list);
+
+        bench_conversion(bench, "listToMatrix", list, listToMatrix);
+        bench_conversion(bench, "listToExtended", list, listToExtended);
+        bench_conversion(bench, "listToMap", list, listToMap);
+        bench_conversion(bench, "matrixToList", matrix, matrixToList);
+        bench_conversion(bench, "matrixToExtended", matrix, matrixToExtended);
+        bench_conversion(bench, "matrixToMap", matrix, matrixToMap);
+        bench_conversion(bench, "extendedToList", ext, extendedToList);
+        bench_conversion(bench, "extendedToMatrix", ext, extendedToMatrix);
+        bench_conversion(bench, "extendedToMap", ext, extendedToMap);
+        bench_conversion(bench, "mapToList", map, mapToList);
+        bench_conversion(bench, "mapToMatrix", map, mapToMatrix);
+        bench_conversion(bench, "mapToExtended", map, mapToExtended);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        return run_represent_batch<MultiBatchTool>(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        return runBench(argc, argv);
+    }
+
     cout << "=== CHUONG TRINH CHUYEN DOI BIEU DIEN DO THI DA BO (KHONG CO KHUYEN) ===\n\n";
 
     int n;
@@ -4,6 +4,22 @@
 #include <unordered_map>
 #include <string>
 #include <set>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+
+#include "../../../common/graph_loader.h" // Graph files in every format (.inp, DIMACS, SGB, .bin, .nga)
+#include "../../../common/footprint.h"    // Heap footprint of the representations
+#include "../../../common/graph_fingerprint.h" // Round-trip checks in batch mode
+#include "../../../common/triangles.h"         // Triangle counts and clustering coefficients
+#include "../../../common/conversion_bench.h"  // --bench grid and heap counters
+#include "../../../common/represent_batch.h"    // --batch driver shared by the represent tools
+
 using namespace std;
 
 // Graph representations
@@ -326,85 +342,85 @@ ExtendedAdjacencyList mapToExtended(const AdjacencyMap& map) {
 }
 
 // Display functions
-void displayMatrix(const AdjacencyMatrix& matrix) {
-    cout << "Adjacency Matrix:\n";
-    cout << "  ";
+void displayMatrix(const AdjacencyMatrix& matrix, ostream& out = cout) {
+    out << "Adjacency Matrix:\n";
+    out << "  ";
     for (int i = 0; i < matrix.n; i++) {
-        cout << i << " ";
+        out << i << " ";
     }
-    cout << "\n";
+    out << "\n";
     
     for (int i = 0; i < matrix.n; i++) {
-        cout << i << " ";
+        out << i << " ";
         for (int j = 0; j < matrix.n; j++) {
-            cout << (matrix.matrix[i][j] ? "1 " : "0 ");
+            out << (matrix.matrix[i][j] ? "1 " : "0 ");
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayList(const AdjacencyList& list) {
-    cout << "Adjacency List:\n";
+void displayList(const AdjacencyList& list, ostream& out = cout) {
+    out << "Adjacency List:\n";
     for (int i = 0; i < list.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int j : list.adj[i]) {
-            cout << j << " ";
+            out << j << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayExtended(const ExtendedAdjacencyList& ext) {
-    cout << "Extended Adjacency List:\n";
-    cout << "Edges: ";
+void displayExtended(const ExtendedAdjacencyList& ext, ostream& out = cout) {
+    out << "Extended Adjacency List:\n";
+    out << "Edges: ";
     for (int i = 0; i < ext.edges.size(); i++) {
-        cout << "(" << ext.edges[i].first << "," << ext.edges[i].second << ") ";
+        out << "(" << ext.edges[i].first << "," << ext.edges[i].second << ") ";
     }
-    cout << "\n";
+    out << "\n";
     
-    cout << "Outgoing edges:\n";
+    out << "Outgoing edges:\n";
     for (int i = 0; i < ext.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int edge : ext.outgoing[i]) {
-            cout << edge << " ";
+            out << edge << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
     
-    cout << "Incoming edges:\n";
+    out << "Incoming edges:\n";
     for (int i = 0; i < ext.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int edge : ext.incoming[i]) {
-            cout << edge << " ";
+            out << edge << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
-void displayMap(const AdjacencyMap& map) {
-    cout << "Adjacency Map:\n";
-    cout << "Outgoing mappings:\n";
+void displayMap(const AdjacencyMap& map, ostream& out = cout) {
+    out << "Adjacency Map:\n";
+    out << "Outgoing mappings:\n";
     for (int i = 0; i < map.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         auto it = map.outgoing.find(i);
         if (it != map.outgoing.end()) {
             for (auto& p : it->second) {
-                cout << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
+                out << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
             }
         }
-        cout << "\n";
+        out << "\n";
     }
     
-    cout << "Incoming mappings:\n";
+    out << "Incoming mappings:\n";
     for (int i = 0; i < map.n; i++) {
-        cout << i << ": ";
+        out << i << ": ";
         auto it = map.incoming.find(i);
         if (it != map.incoming.end()) {
             for (auto& p : it->second) {
-                cout << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
+                out << "(" << p.first << "->" << p.second.first << "," << p.second.second << ") ";
             }
         }
-        cout << "\n";
+        out << "\n";
     }
 }
 
@@ -479,7 +495,173 @@ string getRepName(Representation rep) {
     }
 }
 
-int main() {
+// ========== MEMORY FOOTPRINT ==========
+// Exact number of bytes each representation occupies: the struct itself plus all the heap
+// memory it owns, including container overhead, hash buckets and unused vector capacity
+// (see common/footprint.h).
+
+size_t footprintBytes(const AdjacencyList& list) {
+    return sizeof(list) + heapBytes(list.adj);
+}
+
+size_t footprintBytes(const AdjacencyMatrix& matrix) {
+    return sizeof(matrix) + heapBytes(matrix.matrix);
+}
+
+size_t footprintBytes(const ExtendedAdjacencyList& ext) {
+    return sizeof(ext) + heapBytes(ext.incoming) + heapBytes(ext.outgoing) + heapBytes(ext.edges);
+}
+
+size_t footprintBytes(const AdjacencyMap& map) {
+    return sizeof(map) + heapBytes(map.incoming) + heapBytes(map.outgoing);
+}
+
+// ========== FINGERPRINTS ==========
+// Order-independent fingerprint of the graph each representation holds (see
+// common/graph_fingerprint.h), computed from what the representation stores so that two
+// representations of the same graph compare equal without sorting or printing them.
+
+GraphFingerprint fingerprintOf(const AdjacencyList& list) {
+    GraphFingerprint f;
+    for (int u = 0; u < list.n; u++) {
+        for (int v : list.adj[u]) f.addArc(u, v);
+    }
+    return f;
+}
+
+GraphFingerprint fingerprintOf(const AdjacencyMatrix& matrix) {
+    GraphFingerprint f;
+    for (int i = 0; i < matrix.n; i++) {
+        for (int j = 0; j < matrix.n; j++) {
+            if (matrix.matrix[i][j]) f.addArc(i, j, matrix.matrix[i][j]);
+        }
+    }
+    return f;
+}
+
+// Follows the outgoing incidence lists, so the edge ids and the edges they point to are both checked.
+GraphFingerprint fingerprintOf(const ExtendedAdjacencyList& ext) {
+    GraphFingerprint f;
+    for (int u = 0; u < ext.n; u++) {
+        for (int edge_idx : ext.outgoing[u]) {
+            const pair<int, int>& e = ext.edges[edge_idx];
+            f.addArc(u, e.first == u ? e.second : e.first);
+        }
+    }
+    return f;
+}
+
+GraphFingerprint fingerprintOf(const AdjacencyMap& map) {
+    GraphFingerprint f;
+    for (const auto& vertex : map.outgoing) {
+        for (const auto& edge : vertex.second) f.addArc(vertex.first, edge.first);
+    }
+    return f;
+}
+
+// ========== TRIANGLES ==========
+// Triangle counts and clustering coefficients of the graph in any representation (see
+// common/triangles.h); each representation only lists the neighbors of a vertex, with
+// their multiplicities, and the engine does the rest in parallel.
+
+TriangleStats trianglesOf(const AdjacencyList& list) {
+    return count_triangles(list.n, [&](int u, auto visit) {
+        for (int v : list.adj[u]) visit(v, 1);
+    }, (int)thread::hardware_concurrency());
+}
+
+TriangleStats trianglesOf(const AdjacencyMatrix& matrix) {
+    return count_triangles(matrix.n, [&](int u, auto visit) {
+        for (int v = 0; v < matrix.n; v++) {
+            if (matrix.matrix[u][v]) visit(v, 1);
+        }
+    }, (int)thread::hardware_concurrency());
+}
+
+TriangleStats trianglesOf(const ExtendedAdjacencyList& ext) {
+    return count_triangles(ext.n, [&](int u, auto visit) {
+        for (int edge_idx : ext.outgoing[u]) {
+            const pair<int, int>& e = ext.edges[edge_idx];
+            visit(e.first == u ? e.second : e.first, 1);
+        }
+    }, (int)thread::hardware_concurrency());
+}
+
+TriangleStats trianglesOf(const AdjacencyMap& map) {
+    return count_triangles(map.n, [&](int u, auto visit) {
+        auto it = map.outgoing.find(u);
+        if (it == map.outgoing.end()) return;
+        for (const auto& edge_info : it->second) visit(edge_info.first, 1);
+    }, (int)thread::hardware_concurrency());
+}
+
+// ========== BATCH MODE ==========
+// --batch, shared with the other represent tools by common/represent_batch.h.
+
+struct SimpleBatchTool : RepresentBatchTool {
+    using Rep = Representation;
+    using List = AdjacencyList;
+    using Matrix = AdjacencyMatrix;
+    using Extended = ExtendedAdjacencyList;
+    using Map = AdjacencyMap;
+    static constexpr const char* graph_kind = "do thi don";
+};
+
+// ========== BENCHMARK MODE ==========
+// Usage: represent_simple --bench [n1,n2,...] [d1,d2,...]
+// Generates random simple graphs for every (n, density) pair of the grid, runs each of the
+// conversions on it through run_bench_grid of conversion_bench.h and prints one CSV line per
+// conversion.
+// Density is the probability of each vertex pair being an edge.
+
+// Random simple graph: every pair {u, v}, u != v, is an edge with probability 'density'.
+AdjacencyList generateBenchGraph(int n, double density, mt19937& rng, long long& m) {
+    AdjacencyList list;
+    list.n = n;
+    list.adj.assign(n, vector<int>());
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    m = 0;
+    for (int u = 0; u < n; u++) {
+        for (int v = u + 1; v < n; v++) {
+            if (coin(rng) < density) {
+                list.adj[u].push_back(v);
+                list.adj[v].push_back(u);
+                m++;
+            }
+        }
+    }
+    return list;
+}
+
+int runBench(int argc, char* argv[]) {
+    return run_bench_grid(argc, argv, "simple", generateBenchGraph, [](const BenchCase& bench, const AdjacencyList& list) {
+        AdjacencyMatrix matrix = listToMatrix(list);
+        ExtendedAdjacencyList ext = listToExtended(list);
+        AdjacencyMap map = listToMap(list);
+
+        bench_conversion(bench, "listToMatrix", list, listToMatrix);
+        bench_conversion(bench, "listToExtended", list, listToExtended);
+        bench_conversion(bench, "listToMap", list, listToMap);
+        bench_conversion(bench, "matrixToList", matrix, matrixToList);
+        bench_conversion(bench, "matrixToExtended", matrix, matrixToExtended);
+        bench_conversion(bench, "matrixToMap", matrix, matrixToMap);
+        bench_conversion(bench, "extendedToList", ext, extendedToList);
+        bench_conversion(bench, "extendedToMatrix", ext, extendedToMatrix);
+        bench_conversion(bench, "extendedToMap", ext, extendedToMap);
+        bench_conversion(bench, "mapToList", map, mapToList);
+        bench_conversion(bench, "mapToMatrix", map, mapToMatrix);
+        bench_conversion(bench, "mapToExtended", map, mapToExtended);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        return run_represent_batch<SimpleBatchTool>(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        return runBench(argc, argv);
+    }
+
     cout << "=== CHUONG TRINH CHUYEN DOI BIEU DIEN DO THI DON ===\n\n";
     
     int n, m;
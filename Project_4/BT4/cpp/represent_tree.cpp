@@ -1,9 +1,16 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <queue>
-#include <algorithm> // For std::sort, std::min, std::max
-#include <map> // For temporary use in conversions to handle canonical edges
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+#include "../../../common/footprint.h" // Heap footprint of the representations
+#include "../../../common/tree_relabel.h" // Preorder/BFS renumbering of the nodes
 
 using namespace std;
 
@@ -35,17 +42,23 @@ struct TreeExtendedAdjacencyList {
 
 // Internal representation for easier conversions between tree structures
 // This stores children for each node, which is convenient for building other representations.
+// The lists are kept in CSR form (two contiguous arrays): the children of u are
+// child[offset[u] .. offset[u+1]), in increasing order.
 struct TreeChildrenList {
-    vector<vector<int>> children; // children[u] = list of children of u
-    int n;
-    int root_node; // The root of the tree
+    vector<int> offset; // n + 1 entries
+    vector<int> child;  // n - 1 entries for a tree
+    int n = 0;
+    int root_node = -1; // The root of the tree
+
+    int childCount(int u) const { return offset[u + 1] - offset[u]; }
 };
 
 // Enum for current representation
 enum TreeRepresentation {
     PARENT_ARRAY,
     FCNS_REP,
-    TREE_EAL
+    TREE_EAL,
+    SUCCINCT_BP // Balanced parentheses; batch mode and menu option 9 only
 };
 
 // Global variables to track current state
@@ -62,11 +75,36 @@ string getTreeRepName(TreeRepresentation rep) {
         case PARENT_ARRAY: return "Array of Parents";
         case FCNS_REP: return "First-Child Next-Sibling";
         case TREE_EAL: return "Graph-based (Extended Adjacency List)";
+        case SUCCINCT_BP: return "Balanced Parentheses (succinct)";
         default: return "Unknown";
     }
 }
 
 // ========== CONVERSION FUNCTIONS ==========
+// Every conversion is O(n): the children list is built from a parent array with one counting
+// sort, which emits the children of each node already in increasing order, so there is no
+// per-node sorting and no BFS.
+
+// Builds the children list from parents[v] (-1 for the root) with a counting sort.
+// offset[p] first counts the children of p; after the prefix sums it is the end of p's range,
+// and filling v in decreasing order moves it back to the start, leaving each range sorted.
+TreeChildrenList parentsToChildrenList(const vector<int>& parents, int root_node) {
+    TreeChildrenList cl;
+    cl.n = parents.size();
+    cl.root_node = root_node;
+    cl.offset.assign(cl.n + 1, 0);
+    for (int v = 0; v < cl.n; ++v) {
+        if (parents[v] != -1) cl.offset[parents[v]]++;
+    }
+    for (int u = 1; u <= cl.n; ++u) {
+        cl.offset[u] += cl.offset[u - 1];
+    }
+    cl.child.resize(cl.offset[cl.n]);
+    for (int v = cl.n - 1; v >= 0; --v) {
+        if (parents[v] != -1) cl.child[--cl.offset[parents[v]]] = v;
+    }
+    return cl;
+}
 
 // Converts a TreeChildrenList to a ParentArray.
 // Iterates through children lists to determine each node's parent.
@@ -77,35 +115,20 @@ ParentArray childrenListToParentArray(const TreeChildrenList& cl) {
     pa.root_node = cl.root_node;
 
     for (int u = 0; u < cl.n; ++u) {
-        for (int v : cl.children[u]) {
-            pa.parents[v] = u; // u is the parent of v
+        for (int k = cl.offset[u]; k < cl.offset[u + 1]; ++k) {
+            pa.parents[cl.child[k]] = u; // u is the parent of child[k]
         }
     }
     return pa;
 }
 
 // Converts a ParentArray to a TreeChildrenList.
-// Iterates through the parent array to build children lists.
 TreeChildrenList parentArrayToChildrenList(const ParentArray& pa) {
-    TreeChildrenList cl;
-    cl.n = pa.n;
-    cl.children.resize(cl.n);
-    cl.root_node = pa.root_node;
-
-    for (int v = 0; v < pa.n; ++v) {
-        if (pa.parents[v] != -1) { // If v has a parent
-            cl.children[pa.parents[v]].push_back(v); // Add v to its parent's children list
-        }
-    }
-    // Sort children lists for consistent FCNS conversion later.
-    for (int i = 0; i < cl.n; ++i) {
-        sort(cl.children[i].begin(), cl.children[i].end());
-    }
-    return cl;
+    return parentsToChildrenList(pa.parents, pa.root_node);
 }
 
 // Converts a TreeChildrenList to a First-Child Next-Sibling (FCNS) representation.
-// Assumes children lists are sorted for consistent FCNS output.
+// Children lists are sorted, so siblings are linked in increasing order.
 FCNS childrenListToFCNS(const TreeChildrenList& cl) {
     FCNS fcns;
     fcns.n = cl.n;
@@ -113,169 +136,563 @@ FCNS childrenListToFCNS(const TreeChildrenList& cl) {
     fcns.next_sibling.assign(cl.n, -1); // Initialize all to -1
 
     for (int u = 0; u < cl.n; ++u) {
-        if (!cl.children[u].empty()) {
-            // The first child of u is the first element in its sorted children list
-            fcns.first_child[u] = cl.children[u][0];
-            // For other children, set next_sibling pointers
-            for (size_t i = 0; i < cl.children[u].size() - 1; ++i) {
-                fcns.next_sibling[cl.children[u][i]] = cl.children[u][i+1];
-            }
+        int begin = cl.offset[u], end = cl.offset[u + 1];
+        if (begin == end) continue;
+        fcns.first_child[u] = cl.child[begin]; // The first child of u is the smallest one
+        for (int k = begin; k + 1 < end; ++k) {
+            fcns.next_sibling[cl.child[k]] = cl.child[k + 1];
         }
     }
     return fcns;
 }
 
 // Converts a First-Child Next-Sibling (FCNS) representation to a TreeChildrenList.
-// Requires the root_node to start the traversal and reconstruct the tree structure.
+// Every node is in exactly one sibling chain, the one starting at its parent's first child,
+// so walking all chains yields the parent array; the counting sort puts children in order.
 TreeChildrenList fcnstToChildrenList(const FCNS& fcns, int root_node) {
-    TreeChildrenList cl;
-    cl.n = fcns.n;
-    cl.children.resize(cl.n);
-    cl.root_node = root_node;
-
-    // Use a queue for BFS to traverse the tree and build the children list
-    queue<int> q;
-    q.push(root_node);
-    vector<bool> visited(fcns.n, false);
-    visited[root_node] = true;
-
-    while (!q.empty()) {
-        int u = q.front();
-        q.pop();
-
-        int current_child = fcns.first_child[u];
-        while (current_child != -1) {
-            if (!visited[current_child]) {
-                cl.children[u].push_back(current_child); // u is parent of current_child
-                visited[current_child] = true;
-                q.push(current_child);
-            }
-            current_child = fcns.next_sibling[current_child]; // Move to the next sibling
+    vector<int> parents(fcns.n, -1);
+    for (int u = 0; u < fcns.n; ++u) {
+        for (int c = fcns.first_child[u]; c != -1; c = fcns.next_sibling[c]) {
+            parents[c] = u;
         }
     }
-    // Sort children lists for consistency.
-    for (int i = 0; i < cl.n; ++i) {
-        sort(cl.children[i].begin(), cl.children[i].end());
-    }
-    return cl;
+    return parentsToChildrenList(parents, root_node);
 }
 
 // Converts a TreeChildrenList to a TreeExtendedAdjacencyList (graph-based).
 // Each parent-child relationship becomes an edge in the EAL.
 // The EAL is treated as undirected for tree edges (u,v) and (v,u) point to the same edge index.
+// Edges are numbered in children-list order, so the edge to child[k] has index k, and the
+// incident edges of v are its parent edge plus the contiguous range of its child edges.
 TreeExtendedAdjacencyList childrenListToTreeEAL(const TreeChildrenList& cl) {
     TreeExtendedAdjacencyList teal;
     teal.n = cl.n;
-    teal.incoming.resize(cl.n);
-    teal.outgoing.resize(cl.n);
-    teal.m = 0;
-
+    teal.m = cl.child.size();
+    teal.edges.resize(teal.m);
+    vector<int> parent_edge(cl.n, -1); // Index of the edge from v's parent to v
     for (int u = 0; u < cl.n; ++u) {
-        for (int v : cl.children[u]) {
-            teal.edges.push_back({u, v}); // Store the edge as (parent, child)
-            int edge_idx = teal.edges.size() - 1;
-
-            teal.outgoing[u].push_back(edge_idx); // u has an outgoing edge to v
-            teal.incoming[v].push_back(edge_idx); // v has an incoming edge from u
-
-            // For undirected graph representation of tree edges (as per previous context):
-            teal.outgoing[v].push_back(edge_idx); // v also has an "outgoing" connection to u
-            teal.incoming[u].push_back(edge_idx); // u also has an "incoming" connection from v
-            teal.m++; // Increment total edge count
+        for (int k = cl.offset[u]; k < cl.offset[u + 1]; ++k) {
+            teal.edges[k] = {u, cl.child[k]}; // Store the edge as (parent, child)
+            parent_edge[cl.child[k]] = k;
         }
     }
+
+    // Incoming and outgoing lists are the same: all incident edges in increasing index order.
+    // The parent edge lies in the parent's range, so it comes either before or after v's own.
+    teal.outgoing.resize(cl.n);
+    for (int v = 0; v < cl.n; ++v) {
+        vector<int>& list = teal.outgoing[v];
+        list.reserve(cl.childCount(v) + (parent_edge[v] != -1));
+        if (parent_edge[v] != -1 && parent_edge[v] < cl.offset[v]) list.push_back(parent_edge[v]);
+        for (int k = cl.offset[v]; k < cl.offset[v + 1]; ++k) list.push_back(k);
+        if (parent_edge[v] != -1 && parent_edge[v] >= cl.offset[v + 1]) list.push_back(parent_edge[v]);
+    }
+    teal.incoming = teal.outgoing;
     return teal;
 }
 
 // Converts a TreeExtendedAdjacencyList (graph-based) back to a TreeChildrenList.
-// Requires the root_node to start a BFS traversal to correctly identify parent-child relationships.
+// Edges may be stored in either orientation, so parents are found by peeling leaves towards
+// the root: a non-root vertex of degree 1 hangs off its only remaining neighbour, which is the
+// XOR of its neighbours once the peeled ones are XORed out. O(n) with flat arrays only.
 TreeChildrenList treeEALToChildrenList(const TreeExtendedAdjacencyList& teal, int root_node) {
-    TreeChildrenList cl;
-    cl.n = teal.n;
-    cl.children.resize(cl.n);
-    cl.root_node = root_node;
+    vector<int> parents(teal.n, -1);
+    vector<int> degree(teal.n, 0);
+    vector<int> neighbor_xor(teal.n, 0);
+    for (const auto& edge_pair : teal.edges) {
+        degree[edge_pair.first]++;
+        degree[edge_pair.second]++;
+        neighbor_xor[edge_pair.first] ^= edge_pair.second;
+        neighbor_xor[edge_pair.second] ^= edge_pair.first;
+    }
+
+    // Non-root vertices of degree 1 waiting to be peeled
+    vector<int> leaves;
+    leaves.reserve(teal.n);
+    for (int v = 0; v < teal.n; ++v) {
+        if (v != root_node && degree[v] == 1) leaves.push_back(v);
+    }
+    while (!leaves.empty()) {
+        int v = leaves.back();
+        leaves.pop_back();
+        int p = neighbor_xor[v];
+        parents[v] = p;
+        degree[v] = 0;
+        neighbor_xor[p] ^= v;
+        if (--degree[p] == 1 && p != root_node) leaves.push_back(p);
+    }
+    return parentsToChildrenList(parents, root_node);
+}
 
-    if (cl.n == 0) return cl;
+// ========== SUCCINCT TREE (BALANCED PARENTHESES) ==========
+// The tree shape in 2n bits: a preorder walk writes 1 ('(') on entering a node and 0 (')') on
+// leaving it, so node v, numbered by its preorder rank, is the v-th 1. The excess E(p) is the
+// number of 1s minus the number of 0s in [0, p]. On top of the bits:
+//  - rank directory: number of 1s before every 512-bit block;
+//  - select directory: the position of every 4096th 1 and, below it, the offset of every 64th
+//    1 in 16 bits. A superblock whose 4096 1s spread over 2^16 bits or more keeps the position
+//    of each of its 1s instead, which is at most 2 bits per parenthesis;
+//  - far runs: the parentheses of a block that are unmatched inside it sit at consecutive
+//    levels. For the unmatched opens, the levels are cut into runs whose closes fall into the
+//    same later block; for the unmatched closes (plus the level below them, for parent), into
+//    runs whose last earlier position at that level falls into the same earlier block. A
+//    bitmap with one bit per level marks the run starts, and every run keeps its block.
+//    Matches between blocks do not cross, so there are O(n / 512) runs.
+// In total about 4 bits per node, up to 7 on a path, where every level is a far one.
+// Nodes are always preorder ranks: childrenListToSuccinct renumbers the tree, and the input
+// id of every rank is kept next to the structure by the caller (nothing when the ids already
+// are in preorder), not in it.
+// Every navigation call is O(1). select1 steps over at most 128 rank blocks and 8 words.
+// parent, next_sibling and subtree_size scan one block with byte tables (64 steps); when the
+// answer lies in another block, a popcount over at most 9 words of the run bitmap names that
+// block, and a second scan finds the answer in it.
+class SuccinctTree {
+public:
+    static const long long BLOCK_BITS = 512;
+    static const long long SELECT_SUPER = 4096;         // 1s per select superblock
+    static const long long SELECT_MINI = 64;            // 1s per 16-bit offset in a dense superblock
+    static const long long SELECT_SPARSE_SPAN = 1 << 16; // Span from which every position is kept
 
-    // Build a temporary adjacency list from EAL for BFS traversal.
-    // This handles the undirected nature of TreeExtendedAdjacencyList by creating
-    // a simple adjacency list where each node points to its direct neighbors.
-    vector<vector<int>> temp_adj(teal.n);
-    for (const auto& edge_pair : teal.edges) {
-        temp_adj[edge_pair.first].push_back(edge_pair.second);
-        temp_adj[edge_pair.second].push_back(edge_pair.first); // Undirected connection
+    // Runs of levels of the far parentheses of every block, top level first. A level is
+    // found by its distance from the top of its block.
+    struct FarRuns {
+        vector<uint32_t> first_bit; // Per block: its first bit in marks
+        vector<uint32_t> first_run; // Per block: its first run in target
+        vector<uint64_t> marks;     // 1 where a run starts
+        vector<int32_t> target;     // Block of every run; -1 stands for position -1
+        uint32_t bit_count = 0;
+
+        // Cuts the levels top, top - 1, ..., bottom of block b into runs of equal targetOf(level).
+        template <class TargetOf>
+        void addBlock(long long b, long long top, long long bottom, TargetOf targetOf) {
+            first_bit[b] = bit_count;
+            first_run[b] = (uint32_t)target.size();
+            for (long long level = top; level >= bottom; --level) {
+                int32_t t = targetOf(level);
+                if ((bit_count >> 6) >= marks.size()) marks.push_back(0);
+                if (level == top || t != target.back()) {
+                    marks[bit_count >> 6] |= 1ULL << (bit_count & 63);
+                    target.push_back(t);
+                }
+                bit_count++;
+            }
+        }
+
+        // Target block of the level 'offset' below the top of block b.
+        int32_t targetOf(long long b, long long offset) const {
+            uint64_t from = first_bit[b], to = from + offset; // Runs starting in [from, to]
+            int runs = 0;
+            for (uint64_t w = from >> 6; w <= (to >> 6); ++w) {
+                uint64_t word = marks[w];
+                if (w == (from >> 6)) word &= ~0ULL << (from & 63);
+                if (w == (to >> 6) && (to & 63) != 63) word &= (1ULL << ((to & 63) + 1)) - 1;
+                runs += __builtin_popcountll(word);
+            }
+            return target[first_run[b] + runs - 1];
+        }
+    };
+
+    // Takes the parenthesis bits of an n-node tree.
+    void build(vector<uint64_t> parens, long long nodes) {
+        bits = std::move(parens);
+        n = nodes;
+        length = 2 * nodes;
+        blocks = (length + BLOCK_BITS - 1) / BLOCK_BITS;
+
+        // Rank directory, and the lowest level of every block, the one before it included
+        block_rank.assign(blocks + 1, 0);
+        block_low.assign(blocks, 0);
+        long long ones = 0, excess_so_far = 0, highest = 0;
+        for (long long b = 0; b < blocks; ++b) {
+            block_rank[b] = ones;
+            long long end = min(length, (b + 1) * BLOCK_BITS);
+            long long lowest = excess_so_far;
+            for (long long p = b * BLOCK_BITS; p < end; ++p) {
+                if (isOpen(p)) ones++;
+                excess_so_far += isOpen(p) ? 1 : -1;
+                lowest = min(lowest, excess_so_far);
+                highest = max(highest, excess_so_far);
+            }
+            block_low[b] = (int32_t)lowest;
+        }
+        block_rank[blocks] = ones;
+
+        buildSelect();
+        buildFarRuns(highest);
     }
 
-    queue<int> q;
-    q.push(root_node);
-    vector<bool> visited(cl.n, false);
-    visited[root_node] = true;
+    long long size() const { return n; }
+    bool isOpen(long long p) const { return (bits[p >> 6] >> (p & 63)) & 1; }
+
+    // Number of 1s in positions [0, p).
+    long long rank1(long long p) const {
+        long long b = p / BLOCK_BITS;
+        long long r = block_rank[b];
+        for (long long w = b * (BLOCK_BITS / 64); w < (p >> 6); ++w) r += __builtin_popcountll(bits[w]);
+        if (p & 63) r += __builtin_popcountll(bits[p >> 6] & ((1ULL << (p & 63)) - 1));
+        return r;
+    }
 
-    while (!q.empty()) {
-        int u = q.front();
-        q.pop();
+    // Position of the k-th 1 (k from 0).
+    long long select1(long long k) const {
+        long long super = k / SELECT_SUPER, r = k % SELECT_SUPER;
+        long long ref = select_super_ref[super];
+        if (ref < 0) return select_sparse[-ref - 1 + r];
 
-        for (int v : temp_adj[u]) {
-            if (!visited[v]) {
-                cl.children[u].push_back(v); // If v is not visited, u must be its parent
-                visited[v] = true;
-                q.push(v);
+        // The 1 of the offset is less than 2^16 bits (128 blocks) before the k-th 1
+        long long from = select_super_pos[super] + select_mini[ref + r / SELECT_MINI];
+        long long b = from / BLOCK_BITS;
+        while (block_rank[b + 1] <= k) b++;
+        long long rank = block_rank[b];
+        for (long long w = b * (BLOCK_BITS / 64);; ++w) {
+            uint64_t word = bits[w];
+            long long c = __builtin_popcountll(word);
+            if (rank + c > k) {
+                for (long long j = k - rank; j > 0; --j) word &= word - 1; // Drop the lower 1s
+                return w * 64 + __builtin_ctzll(word);
             }
+            rank += c;
         }
     }
-    // Sort children lists for consistency.
-    for (int i = 0; i < cl.n; ++i) {
-        sort(cl.children[i].begin(), cl.children[i].end());
+
+    // Excess after position p (E(-1) = 0).
+    long long excess(long long p) const { return 2 * rank1(p + 1) - (p + 1); }
+
+    // ----- Navigation; nodes are preorder ranks, -1 means none -----
+    long long openOf(long long v) const { return select1(v); }
+
+    // The parent's open is one after the last position before p at level E(p) - 2.
+    long long parent(long long v) const {
+        long long p = openOf(v);
+        long long target = excess(p) - 2;
+        if (target < 0) return -1; // The root
+        long long b = p / BLOCK_BITS, start = b * BLOCK_BITS;
+        long long j = NONE;
+        if (p > start) j = scanBackward(p - 1, start, excess(p - 1), target);
+        if (j == NONE) {
+            long long before = excess(start - 1);
+            if (before == target) {
+                j = start - 1;
+            } else {
+                int32_t a = open_runs.targetOf(b, before - 1 - target);
+                if (a < 0) {
+                    j = -1;
+                } else {
+                    long long last = min(length, (a + 1) * BLOCK_BITS) - 1;
+                    j = scanBackward(last, a * BLOCK_BITS, excess(last), target);
+                }
+            }
+        }
+        return rank1(j + 1);
     }
-    return cl;
+
+    long long firstChild(long long v) const {
+        long long p = openOf(v);
+        return p + 1 < length && isOpen(p + 1) ? v + 1 : -1;
+    }
+
+    long long nextSibling(long long v) const {
+        long long q = findClose(openOf(v)) + 1;
+        return q < length && isOpen(q) ? rank1(q) : -1;
+    }
+
+    long long depth(long long v) const { return excess(openOf(v)) - 1; }
+
+    long long subtreeSize(long long v) const {
+        long long p = openOf(v);
+        return (findClose(p) - p + 1) / 2;
+    }
+
+    // The close of the open at p: the first position after p at level E(p) - 1.
+    long long findClose(long long p) const {
+        long long e = excess(p), target = e - 1;
+        long long b = p / BLOCK_BITS, end = min(length, (b + 1) * BLOCK_BITS);
+        long long j = scanForward(p + 1, end, e, target);
+        if (j != NONE) return j;
+        int32_t a = close_runs.targetOf(b, excess(end - 1) - 1 - target);
+        return scanForward(a * BLOCK_BITS, min(length, (a + 1) * BLOCK_BITS), excess(a * BLOCK_BITS - 1), target);
+    }
+
+    // Fields are public for the footprint accounting and the conversions.
+    vector<uint64_t> bits;
+    vector<long long> block_rank;
+    vector<int32_t> block_low;
+    vector<long long> select_super_pos; // Position of the first 1 of every superblock
+    vector<long long> select_super_ref; // Index into select_mini, or -1 - index into select_sparse
+    vector<uint16_t> select_mini;
+    vector<uint32_t> select_sparse;
+    FarRuns close_runs; // Unmatched opens: block of the close
+    FarRuns open_runs;  // Unmatched closes and the level below: block of the last earlier position
+    long long n = 0, length = 0, blocks = 0;
+
+private:
+    static const long long NONE = -2;
+
+    void buildSelect() {
+        select_super_pos.clear();
+        select_super_ref.clear();
+        select_mini.clear();
+        select_sparse.clear();
+        vector<long long> positions; // 1s of the current superblock
+        positions.reserve(SELECT_SUPER);
+        auto flush = [&]() {
+            if (positions.empty()) return;
+            long long first = positions[0];
+            select_super_pos.push_back(first);
+            if (positions.back() - first >= SELECT_SPARSE_SPAN) {
+                select_super_ref.push_back(-1 - (long long)select_sparse.size());
+                for (long long pos : positions) select_sparse.push_back((uint32_t)pos);
+            } else {
+                select_super_ref.push_back((long long)select_mini.size());
+                for (size_t i = 0; i < positions.size(); i += SELECT_MINI) select_mini.push_back((uint16_t)(positions[i] - first));
+            }
+            positions.clear();
+        };
+        for (long long w = 0; w < (long long)bits.size(); ++w) {
+            for (uint64_t word = bits[w]; word; word &= word - 1) {
+                positions.push_back(w * 64 + __builtin_ctzll(word));
+                if ((long long)positions.size() == SELECT_SUPER) flush();
+            }
+        }
+        flush();
+    }
+
+    // at_level[l] holds the block of the nearest position at level l on the side already seen:
+    // after the current block for the close runs (blocks right to left), before it for the
+    // open runs (left to right). Every level between 0 and the current one occurs on both sides.
+    void buildFarRuns(long long highest) {
+        vector<int32_t> at_level(highest + 1, -1);
+        close_runs = FarRuns();
+        close_runs.first_bit.assign(blocks, 0);
+        close_runs.first_run.assign(blocks, 0);
+        long long e = 0; // Excess after the current position
+        for (long long b = blocks - 1; b >= 0; --b) {
+            long long start = b * BLOCK_BITS, end = min(length, (b + 1) * BLOCK_BITS);
+            e = excess(end - 1);
+            close_runs.addBlock(b, e - 1, block_low[b], [&](long long level) { return at_level[level]; });
+            for (long long p = end - 1; p >= start; --p) {
+                at_level[e] = (int32_t)b;
+                e -= isOpen(p) ? 1 : -1;
+            }
+        }
+
+        fill(at_level.begin(), at_level.end(), -1); // Level 0 is at position -1
+        open_runs = FarRuns();
+        open_runs.first_bit.assign(blocks, 0);
+        open_runs.first_run.assign(blocks, 0);
+        e = 0;
+        for (long long b = 0; b < blocks; ++b) {
+            long long start = b * BLOCK_BITS, end = min(length, (b + 1) * BLOCK_BITS);
+            open_runs.addBlock(b, e - 1, max<long long>(block_low[b] - 1, 0), [&](long long level) { return at_level[level]; });
+            for (long long p = start; p < end; ++p) {
+                e += isOpen(p) ? 1 : -1;
+                at_level[e] = (int32_t)b;
+            }
+        }
+    }
+
+    // Excess change and minimum prefix excess of every byte, bits taken from the lowest.
+    struct ByteTables {
+        int total[256];
+        int lowest[256];
+        ByteTables() {
+            for (int x = 0; x < 256; ++x) {
+                int e = 0, m = 8;
+                for (int k = 0; k < 8; ++k) {
+                    e += ((x >> k) & 1) ? 1 : -1;
+                    m = min(m, e);
+                }
+                total[x] = e;
+                lowest[x] = m;
+            }
+        }
+    };
+    static const ByteTables& tables() {
+        static const ByteTables t;
+        return t;
+    }
+
+    int byteAt(long long p) const { return (int)((bits[p >> 6] >> (p & 63)) & 0xFF); } // p % 8 == 0
+
+    // First position in [from, to) with excess <= target; e is the excess before 'from'.
+    long long scanForward(long long from, long long to, long long e, long long target) const {
+        const ByteTables& t = tables();
+        long long p = from;
+        while (p < to) {
+            if ((p & 7) == 0 && p + 8 <= to) {
+                int x = byteAt(p);
+                if (e + t.lowest[x] > target) {
+                    e += t.total[x];
+                    p += 8;
+                    continue;
+                }
+            }
+            e += isOpen(p) ? 1 : -1;
+            if (e <= target) return p;
+            ++p;
+        }
+        return NONE;
+    }
+
+    // Last position in [to, from] with excess <= target; e is the excess at 'from'.
+    long long scanBackward(long long from, long long to, long long e, long long target) const {
+        const ByteTables& t = tables();
+        long long p = from;
+        while (p >= to) {
+            if ((p & 7) == 7 && p - 7 >= to) {
+                int x = byteAt(p - 7);
+                long long before = e - t.total[x]; // Excess at p - 8
+                if (before + t.lowest[x] > target) {
+                    e = before;
+                    p -= 8;
+                    continue;
+                }
+            }
+            if (e <= target) return p;
+            e -= isOpen(p) ? 1 : -1;
+            --p;
+        }
+        return NONE;
+    }
+};
+
+// Writes the parentheses of a preorder walk over the children list, with an explicit stack
+// of (node, next child slot). Children are sorted, so the order matches FCNS.
+// The succinct nodes are the preorder ranks; ids receives the input id of every rank, or is
+// left empty when every node already is its own rank.
+SuccinctTree childrenListToSuccinct(const TreeChildrenList& cl, vector<int>& ids) {
+    long long n = cl.n;
+    vector<uint64_t> parens((2 * n + 63) / 64, 0);
+    ids.assign(n, 0);
+    bool preorder_ids = true;
+    long long pos = 0, rank = 0;
+    vector<pair<int, int>> stack;
+
+    auto enter = [&](int v) {
+        parens[pos >> 6] |= 1ULL << (pos & 63);
+        pos++;
+        ids[rank] = v;
+        preorder_ids = preorder_ids && v == rank;
+        rank++;
+        stack.push_back({v, cl.offset[v]});
+    };
+    if (n > 0) enter(cl.root_node);
+    while (!stack.empty()) {
+        pair<int, int>& top = stack.back();
+        if (top.second < cl.offset[top.first + 1]) {
+            enter(cl.child[top.second++]);
+        } else {
+            pos++; // Closing parenthesis is a 0 bit
+            stack.pop_back();
+        }
+    }
+    if (preorder_ids) ids = vector<int>();
+
+    SuccinctTree st;
+    st.build(std::move(parens), n);
+    return st;
+}
+
+// Recovers the parent of every node with one scan over the parentheses, keeping the open
+// nodes on a stack; the counting sort then rebuilds the sorted children lists with the input
+// ids (ids as returned by childrenListToSuccinct).
+TreeChildrenList succinctToChildrenList(const SuccinctTree& st, const vector<int>& ids) {
+    auto id = [&](long long v) { return ids.empty() ? (int)v : ids[v]; };
+    vector<int> parents(st.n, -1);
+    vector<long long> open_nodes;
+    long long rank = 0;
+    for (long long p = 0; p < st.length; ++p) {
+        if (st.isOpen(p)) {
+            if (!open_nodes.empty()) parents[id(rank)] = id(open_nodes.back());
+            open_nodes.push_back(rank++);
+        } else {
+            open_nodes.pop_back();
+        }
+    }
+    return parentsToChildrenList(parents, st.n > 0 ? id(0) : -1);
+}
+
+// Renumbers the nodes in preorder or BFS order (the root becomes 0) and stores the input id of
+// every new node in original. The children lists keep their order, so they stay sorted.
+// In preorder every subtree is a contiguous range of ids, the conversions walk the arrays
+// front to back, and the BP form needs no id map.
+TreeChildrenList relabelChildrenList(const TreeChildrenList& cl, RelabelOrder order, vector<int>& original) {
+    RelabeledTree t = relabel_tree(cl.n, cl.root_node, [&](int u) {
+        return IdRange{cl.child.data() + cl.offset[u], cl.child.data() + cl.offset[u + 1]};
+    }, order);
+    TreeChildrenList relabeled;
+    relabeled.n = t.n;
+    relabeled.root_node = t.n > 0 ? 0 : -1;
+    relabeled.offset = std::move(t.offset);
+    relabeled.child = std::move(t.child);
+    original = std::move(t.original);
+    return relabeled;
 }
 
 // ========== DISPLAY FUNCTIONS ==========
 
 // Displays the Array of Parents representation.
-void displayParentArray(const ParentArray& pa) {
-    cout << "Array of Parents:\n";
-    cout << "Root: " << pa.root_node << "\n";
+void displayParentArray(const ParentArray& pa, ostream& out = cout) {
+    out << "Array of Parents:\n";
+    out << "Root: " << pa.root_node << "\n";
     for (int i = 0; i < pa.n; ++i) {
-        cout << "Parent[" << i << "] = " << pa.parents[i] << "\n";
+        out << "Parent[" << i << "] = " << pa.parents[i] << "\n";
     }
 }
 
 // Displays the First-Child Next-Sibling representation.
-void displayFCNS(const FCNS& fcns) {
-    cout << "First-Child Next-Sibling Representation:\n";
+void displayFCNS(const FCNS& fcns, ostream& out = cout) {
+    out << "First-Child Next-Sibling Representation:\n";
     for (int i = 0; i < fcns.n; ++i) {
-        cout << "Node " << i << ": ";
-        cout << "First Child = " << fcns.first_child[i];
-        cout << ", Next Sibling = " << fcns.next_sibling[i] << "\n";
+        out << "Node " << i << ": ";
+        out << "First Child = " << fcns.first_child[i];
+        out << ", Next Sibling = " << fcns.next_sibling[i] << "\n";
     }
 }
 
 // Displays the Graph-based representation (TreeExtendedAdjacencyList).
-void displayTreeEAL(const TreeExtendedAdjacencyList& teal) {
-    cout << "Graph-based Representation (Extended Adjacency List):\n";
-    cout << "Total Edges (m): " << teal.m << "\n";
-    cout << "Edges (u,v) and their indices:\n";
+void displayTreeEAL(const TreeExtendedAdjacencyList& teal, ostream& out = cout) {
+    out << "Graph-based Representation (Extended Adjacency List):\n";
+    out << "Total Edges (m): " << teal.m << "\n";
+    out << "Edges (u,v) and their indices:\n";
     for (int i = 0; i < teal.edges.size(); ++i) {
-        cout << "  Edge " << i << ": (" << teal.edges[i].first << "," << teal.edges[i].second << ")\n";
+        out << "  Edge " << i << ": (" << teal.edges[i].first << "," << teal.edges[i].second << ")\n";
     }
 
-    cout << "Outgoing edges (indices):\n";
+    out << "Outgoing edges (indices):\n";
     for (int i = 0; i < teal.n; ++i) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int edge_idx : teal.outgoing[i]) {
-            cout << edge_idx << " ";
+            out << edge_idx << " ";
         }
-        cout << "\n";
+        out << "\n";
     }
 
-    cout << "Incoming edges (indices):\n";
+    out << "Incoming edges (indices):\n";
     for (int i = 0; i < teal.n; ++i) {
-        cout << i << ": ";
+        out << i << ": ";
         for (int edge_idx : teal.incoming[i]) {
-            cout << edge_idx << " ";
+            out << edge_idx << " ";
         }
-        cout << "\n";
+        out << "\n";
+    }
+}
+
+// Displays the succinct representation: the parentheses, then every node (in preorder) with
+// the navigation answers computed from the bits, under the input ids.
+void displaySuccinct(const SuccinctTree& st, const vector<int>& ids, ostream& out = cout) {
+    out << "Balanced Parentheses (succinct):\n";
+    out << "Bits: ";
+    for (long long p = 0; p < st.length; ++p) {
+        out << (st.isOpen(p) ? '(' : ')');
+    }
+    out << "\n";
+    auto id = [&](long long v) { return v == -1 || ids.empty() ? (int)v : ids[v]; };
+    for (long long v = 0; v < st.n; ++v) {
+        out << "Node " << id(v) << ": Parent = " << id(st.parent(v))
+            << ", First Child = " << id(st.firstChild(v))
+            << ", Next Sibling = " << id(st.nextSibling(v))
+            << ", Depth = " << st.depth(v) << ", Subtree Size = " << st.subtreeSize(v) << "\n";
     }
 }
 
@@ -295,6 +712,8 @@ void displayCurrentTreeRepresentation() {
             cout << " (Graph-based (Extended Adjacency List))\n";
             displayTreeEAL(current_tree_eal);
             break;
+        case SUCCINCT_BP: // Never current in the menu; option 9 only displays it
+            break;
     }
     cout << "\n";
 }
@@ -318,22 +737,303 @@ bool isValidTreeConversion(int choice) {
             return current_tree_rep == TREE_EAL;
         case 8: // Exit
             return true;
+        case 9: // Show the succinct form of the current tree
+            return true;
         default:
             return false;
     }
 }
 
-int main() {
+// ========== MEMORY FOOTPRINT ==========
+// Exact number of bytes each representation occupies: the struct itself plus all the heap
+// memory it owns, including unused vector capacity (see common/footprint.h).
+
+size_t footprintBytes(const ParentArray& pa) {
+    return sizeof(pa) + heapBytes(pa.parents);
+}
+
+size_t footprintBytes(const FCNS& fcns) {
+    return sizeof(fcns) + heapBytes(fcns.first_child) + heapBytes(fcns.next_sibling);
+}
+
+size_t footprintBytes(const TreeExtendedAdjacencyList& eal) {
+    return sizeof(eal) + heapBytes(eal.edges) + heapBytes(eal.incoming) + heapBytes(eal.outgoing);
+}
+
+size_t footprintBytes(const SuccinctTree& st) {
+    auto runBytes = [](const SuccinctTree::FarRuns& runs) {
+        return heapBytes(runs.first_bit) + heapBytes(runs.first_run) + heapBytes(runs.marks) + heapBytes(runs.target);
+    };
+    return sizeof(st) + heapBytes(st.bits) + heapBytes(st.block_rank) + heapBytes(st.block_low) +
+           heapBytes(st.select_super_pos) + heapBytes(st.select_super_ref) + heapBytes(st.select_mini) +
+           heapBytes(st.select_sparse) + runBytes(st.close_runs) + runBytes(st.open_runs);
+}
+
+// ========== BATCH MODE ==========
+// Usage: represent_tree --batch <input.inp> <chain> [output] [--footprint] [--relabel pre|bfs]
+// The input file has the same format as the interactive input (n, then "<so_con> <con_1> ..."
+// for every node). <chain> is a comma separated list of representations (PA, FCNS, EAL, BP)
+// starting from the Array of Parents, e.g. "PA,FCNS,EAL". Only the final representation is
+// written (to stdout when no output file is given); per-step timings are reported on stderr.
+// Every step also reports the footprint of its result. With --footprint the tree is first
+// built in each of the four representations and a table of their footprints is printed
+// on stderr with the smallest one recommended.
+// With --relabel the nodes are first renumbered in preorder (pre) or BFS order (bfs); the
+// representation is written with the new ids, followed by the original id of every node.
+
+// Holds the tree in one representation at a time; the previous one is released after each step.
+struct BatchTree {
+    TreeRepresentation rep = PARENT_ARRAY;
+    ParentArray parent_array;
+    FCNS fcns;
+    TreeExtendedAdjacencyList eal;
+    SuccinctTree bp;
+    vector<int> bp_ids; // Input id of every preorder rank of bp; empty when they are the same
+    int root_node;
+    vector<int> original; // Input id of every node after --relabel; empty otherwise
+};
+
+// Parses a representation name used in the conversion chain.
+bool parseTreeRepName(const string& name, TreeRepresentation& rep) {
+    if (name == "PA") rep = PARENT_ARRAY;
+    else if (name == "FCNS") rep = FCNS_REP;
+    else if (name == "EAL") rep = TREE_EAL;
+    else if (name == "BP") rep = SUCCINCT_BP;
+    else return false;
+    return true;
+}
+
+// Reads a tree file into a TreeChildrenList, with the same validation as the interactive input.
+bool readTreeFile(const string& path, TreeChildrenList& cl) {
+    ifstream in(path);
+    if (!in.is_open()) {
+        cerr << "Loi: Khong mo duoc file " << path << "\n";
+        return false;
+    }
+    int n;
+    if (!(in >> n) || n < 0) {
+        cerr << "Loi: Dong dau tien phai la so dinh n\n";
+        return false;
+    }
+    vector<int> parents(n, -1); // Children are recorded as parents, then sorted by parentsToChildrenList
+    for (int i = 0; i < n; ++i) {
+        int num_children;
+        if (!(in >> num_children) || num_children < 0) {
+            cerr << "Loi: Thieu danh sach con cua dinh " << i << "\n";
+            return false;
+        }
+        for (int k = 0; k < num_children; ++k) {
+            int child_node;
+            if (!(in >> child_node)) {
+                cerr << "Loi: Thieu dinh con cua dinh " << i << "\n";
+                return false;
+            }
+            if (child_node < 0 || child_node >= n || child_node == i) {
+                cerr << "Loi: Dinh con " << child_node << " cua dinh " << i << " khong hop le\n";
+                return false;
+            }
+            if (parents[child_node] != -1) {
+                cerr << "Loi: Dinh " << child_node << " co nhieu hon mot cha\n";
+                return false;
+            }
+            parents[child_node] = i;
+        }
+    }
+
+    int root = -1;
+    int root_count = 0;
+    for (int i = 0; i < n; ++i) {
+        if (parents[i] == -1) {
+            root = i;
+            root_count++;
+        }
+    }
+    if (n > 0 && root_count != 1) {
+        cerr << "Loi: Do thi khong phai la cay (phai co dung mot goc).\n";
+        return false;
+    }
+    cl = parentsToChildrenList(parents, root);
+    return true;
+}
+
+// Applies one of the 6 conversions in place, going through the children list like the menu does.
+void convertBatchTree(BatchTree& t, TreeRepresentation to) {
+    if (t.rep == to) return;
+    TreeChildrenList cl;
+    switch (t.rep) {
+        case PARENT_ARRAY:
+            cl = parentArrayToChildrenList(t.parent_array);
+            t.parent_array = ParentArray();
+            break;
+        case FCNS_REP:
+            cl = fcnstToChildrenList(t.fcns, t.root_node);
+            t.fcns = FCNS();
+            break;
+        case TREE_EAL:
+            cl = treeEALToChildrenList(t.eal, t.root_node);
+            t.eal = TreeExtendedAdjacencyList();
+            break;
+        case SUCCINCT_BP:
+            cl = succinctToChildrenList(t.bp, t.bp_ids);
+            t.bp = SuccinctTree();
+            t.bp_ids = vector<int>();
+            break;
+    }
+    switch (to) {
+        case PARENT_ARRAY: t.parent_array = childrenListToParentArray(cl); break;
+        case FCNS_REP: t.fcns = childrenListToFCNS(cl); break;
+        case TREE_EAL: t.eal = childrenListToTreeEAL(cl); break;
+        case SUCCINCT_BP: t.bp = childrenListToSuccinct(cl, t.bp_ids); break;
+    }
+    t.rep = to;
+}
+
+// Writes the representation the tree is currently in, using the display format.
+void writeBatchTree(const BatchTree& t, ostream& out) {
+    switch (t.rep) {
+        case PARENT_ARRAY: displayParentArray(t.parent_array, out); break;
+        case FCNS_REP: displayFCNS(t.fcns, out); break;
+        case TREE_EAL: displayTreeEAL(t.eal, out); break;
+        case SUCCINCT_BP: displaySuccinct(t.bp, t.bp_ids, out); break;
+    }
+    if (!t.original.empty()) {
+        out << "Original Node IDs:\n";
+        for (size_t i = 0; i < t.original.size(); ++i) {
+            out << "Node " << i << " = " << t.original[i] << "\n";
+        }
+    }
+}
+
+// Footprint of the representation the tree is currently in.
+size_t footprintBatchTree(const BatchTree& t) {
+    switch (t.rep) {
+        case PARENT_ARRAY: return footprintBytes(t.parent_array);
+        case FCNS_REP: return footprintBytes(t.fcns);
+        case TREE_EAL: return footprintBytes(t.eal);
+        case SUCCINCT_BP: return footprintBytes(t.bp);
+    }
+    return 0;
+}
+
+// Builds every representation from the children list, one at a time, and prints the
+// footprint table with the smallest representation.
+void printTreeFootprintTable(const TreeChildrenList& cl) {
+    size_t bytes[4];
+    bytes[PARENT_ARRAY] = footprintBytes(childrenListToParentArray(cl));
+    bytes[FCNS_REP] = footprintBytes(childrenListToFCNS(cl));
+    bytes[TREE_EAL] = footprintBytes(childrenListToTreeEAL(cl));
+    vector<int> bp_ids;
+    bytes[SUCCINCT_BP] = footprintBytes(childrenListToSuccinct(cl, bp_ids));
+
+    TreeRepresentation best = PARENT_ARRAY;
+    cerr << "Bo nho (" << cl.n << " dinh):\n";
+    for (TreeRepresentation rep : {PARENT_ARRAY, FCNS_REP, TREE_EAL, SUCCINCT_BP}) {
+        cerr << "  " << left << setw(40) << getTreeRepName(rep) << right << setw(14) << bytes[rep] << " bytes\n";
+        if (bytes[rep] < bytes[best]) best = rep;
+    }
+    if (!bp_ids.empty()) { // Kept beside the BP structure, like the ids of --relabel
+        cerr << "  (BP: dinh khong theo preorder, bang so hieu goc them " << heapBytes(bp_ids)
+             << " bytes; --relabel pre bo bang nay)\n";
+    }
+    cerr << "Nen dung: " << getTreeRepName(best) << " (nho nhat cho cay nay)\n";
+}
+
+double elapsedMs(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int runBatch(int argc, char* argv[]) {
+    if (argc < 4) {
+        cerr << "Cach dung: " << argv[0] << " --batch <input.inp> <PA,FCNS,EAL,BP,...> [output] [--footprint] [--relabel pre|bfs]\n";
+        return 1;
+    }
+
+    string output_path;
+    bool footprint = false;
+    bool relabel = false;
+    RelabelOrder relabel_order = RelabelOrder::PREORDER;
+    for (int i = 4; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--footprint") {
+            footprint = true;
+        } else if (arg == "--relabel") {
+            string order = i + 1 < argc ? argv[++i] : "";
+            if (order == "pre") relabel_order = RelabelOrder::PREORDER;
+            else if (order == "bfs") relabel_order = RelabelOrder::BFS;
+            else {
+                cerr << "Loi: --relabel can \"pre\" hoac \"bfs\"\n";
+                return 1;
+            }
+            relabel = true;
+        } else {
+            output_path = arg;
+        }
+    }
+
+    vector<TreeRepresentation> chain;
+    stringstream chain_ss(argv[3]);
+    string name;
+    while (getline(chain_ss, name, ',')) {
+        TreeRepresentation rep;
+        if (!parseTreeRepName(name, rep)) {
+            cerr << "Loi: Bieu dien \"" << name << "\" khong hop le (dung PA, FCNS, EAL, BP)\n";
+            return 1;
+        }
+        chain.push_back(rep);
+    }
+
+    BatchTree t;
+    auto start = chrono::steady_clock::now();
+    TreeChildrenList cl;
+    if (!readTreeFile(argv[2], cl)) return 1;
+    if (relabel) { // Timed on its own line; the "Doc file" time below includes it
+        auto relabel_start = chrono::steady_clock::now();
+        cl = relabelChildrenList(cl, relabel_order, t.original);
+        cerr << "Danh so lai (" << (relabel_order == RelabelOrder::PREORDER ? "preorder" : "BFS") << "): "
+             << elapsedMs(relabel_start) << " ms\n";
+    }
+    t.root_node = cl.root_node;
+    t.parent_array = childrenListToParentArray(cl);
+    if (footprint) printTreeFootprintTable(cl);
+    cl = TreeChildrenList();
+    cerr << "Doc file: " << elapsedMs(start) << " ms, " << footprintBatchTree(t) << " bytes\n";
+
+    for (size_t i = 0; i < chain.size(); i++) {
+        TreeRepresentation from = t.rep;
+        start = chrono::steady_clock::now();
+        convertBatchTree(t, chain[i]);
+        cerr << "Buoc " << i + 1 << ": " << getTreeRepName(from) << " -> " << getTreeRepName(chain[i])
+             << ": " << elapsedMs(start) << " ms, " << footprintBatchTree(t) << " bytes\n";
+    }
+
+    start = chrono::steady_clock::now();
+    if (!output_path.empty()) {
+        ofstream out(output_path);
+        if (!out.is_open()) {
+            cerr << "Loi: Khong ghi duoc file " << output_path << "\n";
+            return 1;
+        }
+        writeBatchTree(t, out);
+    } else {
+        ios::sync_with_stdio(false);
+        writeBatchTree(t, cout);
+    }
+    cerr << "Ghi ket qua: " << elapsedMs(start) << " ms\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        return runBatch(argc, argv);
+    }
+
     cout << "=== CHUONG TRINH CHUYEN DOI BIEU DIEN CAY ===\n\n";
 
     int n;
     cout << "Nhap so dinh: ";
     cin >> n;
 
-    current_children_list_internal.n = n;
-    current_children_list_internal.children.resize(n);
-
-    vector<int> in_degree(n, 0); // Used to find the root (node with in-degree 0)
+    vector<int> parents(n, -1); // Children are recorded as parents; root = the node without one
 
     cout << "Nhap danh sach con cho tung dinh (vd: <so_con> <con_1> <con_2> ...):\n";
     cout << "Luu y: Dinh con phai nam trong khoang [0, n-1].\n";
@@ -354,19 +1054,20 @@ int main() {
                 k--;
                 continue;
             }
-            current_children_list_internal.children[i].push_back(child_node);
-            in_degree[child_node]++;
+            if (parents[child_node] != -1) { // Every node of a tree has at most one parent
+                cout << "Loi: Dinh " << child_node << " da co cha. Vui long nhap lai dinh con nay.\n";
+                k--;
+                continue;
+            }
+            parents[child_node] = i;
         }
-        // Sort children for consistent FCNS conversion later.
-        // This is crucial because FCNS relies on a defined order of siblings.
-        sort(current_children_list_internal.children[i].begin(), current_children_list_internal.children[i].end());
     }
 
     // Find the root of the tree
     int root = -1;
     int root_count = 0;
     for (int i = 0; i < n; ++i) {
-        if (in_degree[i] == 0) {
+        if (parents[i] == -1) {
             root = i;
             root_count++;
         }
@@ -377,7 +1078,8 @@ int main() {
         cout << "Loi: Do thi khong phai la cay (phai co dung mot goc).\n";
         return 1; // Exit if not a valid tree
     }
-    current_children_list_internal.root_node = root;
+    // Children come out sorted, which FCNS relies on for a defined order of siblings
+    current_children_list_internal = parentsToChildrenList(parents, root);
 
     // Initialize current_parent_array from the initial children list
     current_parent_array = childrenListToParentArray(current_children_list_internal);
@@ -396,6 +1098,7 @@ int main() {
         cout << "6. Graph-based (Extended Adjacency List) -> Array of Parents\n";
         cout << "7. Graph-based (Extended Adjacency List) -> First-Child Next-Sibling\n";
         cout << "\n8. Thoat\n";
+        cout << "9. Xem dang succinct (Balanced Parentheses) cua cay hien tai\n";
         cout << "Chon: ";
 
         int choice;
@@ -471,6 +1174,16 @@ int main() {
             case 8:
                 cout << "Tam biet!\n";
                 return 0;
+            case 9: { // Current tree -> Balanced Parentheses, shown without changing the current representation
+                vector<int> ids;
+                SuccinctTree st = childrenListToSuccinct(current_children_list_internal, ids);
+                cout << "\n";
+                displaySuccinct(st, ids);
+                cout << "Bo nho: " << footprintBytes(st) << " bytes";
+                if (!ids.empty()) cout << " (+ " << heapBytes(ids) << " bytes bang so hieu goc)";
+                cout << "\n";
+                break;
+            }
             default:
                 cout << "Lua chon khong hop le!\n";
         }
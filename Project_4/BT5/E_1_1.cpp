@@ -1,50 +1,214 @@
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include "../../common/dimacs_csr.h"   // DIMACS line scanner and CSR loader
+#include "../../common/graph_archive.h" // Compressed graph archives (.nga)
+#include "../../common/mapped_file.h"   // Read-only mapping of the input file
+#include "../../common/text_writer.h" // Buffered output of the writers
 
 using namespace std;
 
 using Edge = pair<int, int>;
 
-// Reads DIMACS format graph from file
-bool read_dimacs(const string& file_path, int& n, int& m, vector<Edge>& edges) {
-    ifstream infile(file_path);
-    if (!infile.is_open()) return false;
+// ========== DIMACS READER ==========
+// read_dimacs parses the mapped file with scan_dimacs_chunk of common/dimacs_csr.h, and the
+// edge array is reserved once from the edge count of the 'p' line.
+
+// Parses a chunk, appending its edges to edges. With presize the edge array is reserved
+// from the 'p' line, which is only worth it when the chunk is the whole file.
+void parse_dimacs_chunk(const char* data, size_t begin, size_t end, size_t file_size, bool presize,
+                      vector<Edge>& edges, DimacsChunkInfo& info) {
+    scan_dimacs_chunk(data, begin, end, info,
+        [&](int, int file_m) {
+            if (presize) {
+                // Every edge line takes at least 6 bytes ("e 1 2\n"), which bounds a bogus m
+                size_t expected = (size_t)(file_m > 0 ? file_m : 0);
+                if (expected > file_size / 6 + 1) expected = file_size / 6 + 1;
+                edges.reserve(edges.size() + expected);
+            }
+            return true;
+        },
+        [&](int u, int v) {
+            edges.push_back(Edge(u, v));
+            return true;
+        });
+}
+
+// Bytes per thread below which more threads are not worth starting.
+const size_t DIMACS_MIN_BYTES_PER_THREAD = 1 << 20;
 
-    string line;
+// Parses the DIMACS text [data, data + size) on up to 'threads' threads. On a malformed line
+// returns false with its byte offset in error_offset, keeping the edges before it; n and m
+// are only set by a 'p' line, the last one before the error.
+//
+// In parallel the text is cut into one chunk per thread at line starts, every thread parses
+// its chunk into its own edge buffer, and the buffers are copied to their place in edges,
+// given by a prefix sum over the chunk edge counts, so the edges keep the file order. The
+// first malformed line of the file is in the first chunk that has one.
+bool parse_dimacs(const char* data, size_t size, int& n, int& m, vector<Edge>& edges, size_t& error_offset,
+                 int threads = 1) {
+    threads = (int)max<size_t>(1, min<size_t>(threads, size / DIMACS_MIN_BYTES_PER_THREAD));
     edges.clear();
+    if (threads == 1) {
+        DimacsChunkInfo info;
+        parse_dimacs_chunk(data, 0, size, size, true, edges, info);
+        if (info.has_p) {
+            n = info.n;
+            m = info.m;
+        }
+        error_offset = info.error_offset;
+        return !info.malformed;
+    }
+
+    // Chunk t starts at the first line start at or after size * t / threads
+    vector<size_t> bound(threads + 1, size);
+    bound[0] = 0;
+    for (int t = 1; t < threads; t++) {
+        size_t at = max(bound[t - 1], size * t / threads);
+        if (at > 0 && at < size && data[at - 1] != '\n') {
+            const char* eol = (const char*)memchr(data + at, '\n', size - at);
+            at = eol == nullptr ? size : eol - data + 1;
+        }
+        bound[t] = at;
+    }
+
+    vector<vector<Edge>> chunk_edges(threads);
+    vector<DimacsChunkInfo> info(threads);
+    auto parse = [&](int t) {
+        parse_dimacs_chunk(data, bound[t], bound[t + 1], size, false, chunk_edges[t], info[t]);
+    };
+    vector<thread> workers;
+    for (int t = 1; t < threads; t++) workers.emplace_back(parse, t);
+    parse(0);
+    for (auto& w : workers) w.join();
 
-    while (getline(infile, line)) {
-        if (line.empty() || line[0] == 'c') continue;
-
-        istringstream iss(line);
-        if (line[0] == 'p') {
-            string p, format;
-            iss >> p >> format >> n >> m;
-        } else if (line[0] == 'e') {
-            char e;
-            int u, v;
-            iss >> e >> u >> v;
-            edges.emplace_back(u, v);
+    // Chunks after the first malformed line are dropped
+    int last = 0;
+    while (last < threads - 1 && !info[last].malformed) last++;
+    vector<size_t> start(last + 2, 0);
+    for (int t = 0; t <= last; t++) {
+        start[t + 1] = start[t] + chunk_edges[t].size();
+        if (info[t].has_p) {
+            n = info[t].n;
+            m = info[t].m;
         }
     }
 
-    infile.close();
+    edges.resize(start[last + 1]);
+    auto place = [&](int t) {
+        copy(chunk_edges[t].begin(), chunk_edges[t].end(), edges.begin() + start[t]);
+        vector<Edge>().swap(chunk_edges[t]);
+    };
+    workers.clear();
+    for (int t = 1; t <= last; t++) workers.emplace_back(place, t);
+    place(0);
+    for (auto& w : workers) w.join();
+
+    error_offset = info[last].error_offset;
+    return !info[last].malformed;
+}
+
+// Reads DIMACS format graph from file; on failure error holds the reason, with the byte
+// offset of the first malformed line. threads > 1 parses the file in parallel, and
+// threads <= 0 uses every hardware thread; the result is the same in every mode.
+bool read_dimacs(const string& file_path, int& n, int& m, vector<Edge>& edges, string& error, int threads = 1) {
+    if (threads <= 0) threads = max(1, (int)thread::hardware_concurrency());
+    MappedFile file;
+    if (!file.open(file_path, error)) return false;
+
+    size_t error_offset = 0;
+    if (!parse_dimacs(file.data(), file.size(), n, m, edges, error_offset, threads)) {
+        const char* line = file.data() + error_offset;
+        error = file_path + ": malformed '" + string(1, *line) + "' line at byte offset " + to_string(error_offset);
+        return false;
+    }
     return true;
 }
 
-// Writes DIMACS format graph to file
-bool write_dimacs(int n, const vector<Edge>& edges, const string& file_path) {
-    ofstream outfile(file_path);
-    if (!outfile.is_open()) return false;
+// Reads DIMACS format graph from file
+bool read_dimacs(const string& file_path, int& n, int& m, vector<Edge>& edges) {
+    string error;
+    if (!read_dimacs(file_path, n, m, edges, error)) {
+        cerr << error << "\n";
+        return false;
+    }
+    return true;
+}
+
+// read_dimacs_csr, which loads a DIMACS file straight into CSR form, is in common/dimacs_csr.h.
+
+// Writes DIMACS format graph to file, through the buffered writer of common/text_writer.h;
+// threads > 1 formats the edge lines in parallel, and the file is the same in every mode.
+bool write_dimacs(int n, const vector<Edge>& edges, const string& file_path, int threads = 1) {
+    TextWriter out;
+    if (!out.open(file_path)) return false;
+
+    out << "p edge " << n << " " << edges.size() << "\n";
+    write_lines(out, edges.size(), threads, [&](size_t i, TextBuffer& line) {
+        line << "e " << edges[i].first << " " << edges[i].second << "\n";
+    });
+
+    return out.close();
+}
+
+// ========== GRAPH ARCHIVE ==========
+// Converters between DIMACS and the compressed archive of common/graph_archive.h. A DIMACS
+// graph is stored as an undirected archive of 0-based vertices, so vertex v of the file is
+// archive vertex v - 1, and every edge once, at its lower end. Reading it back gives every
+// edge once as (u, v) with u <= v, sorted; the edge multiset is kept, the order of the lines
+// and of the endpoints is not.
 
-    outfile << "p edge " << n << " " << edges.size() << "\n";
-    for (const auto& [u, v] : edges) {
-        outfile << "e " << u << " " << v << "\n";
+// Converts a DIMACS file to an archive, through read_dimacs_csr. The rows of the CSR hold
+// both ends of every edge (a loop twice); they are cut down in place to the lower ends.
+bool dimacs_to_archive(const string& dimacs_path, const string& archive_path, string& error) {
+    DimacsCSR graph;
+    if (!read_dimacs_csr(dimacs_path, graph, error)) return false;
+    long long kept = 0;
+    for (int v = 0; v < graph.n; ++v) {
+        long long begin = graph.offset[v], end = graph.offset[v + 1];
+        graph.offset[v] = kept;
+        bool loop_pending = false;
+        for (long long k = begin; k < end; ++k) {
+            int u = graph.neighbor[k];
+            if (u == v) loop_pending = !loop_pending;
+            if (u > v || (u == v && loop_pending)) graph.neighbor[kept++] = u;
+        }
+    }
+    graph.offset[graph.n] = kept;
+    graph.neighbor.resize(kept);
+    return write_graph_archive(archive_path, graph.n, graph.m, true, graph.offset, graph.neighbor, {}, {}, error);
+}
+
+// Reads an undirected archive into the n, m and edges of read_dimacs, with 1-based vertices.
+bool read_dimacs_archive(const string& archive_path, int& n, int& m, vector<Edge>& edges, string& error) {
+    GraphArchive archive;
+    if (!archive.open(archive_path, error)) return false;
+    if (!archive.symmetric()) {
+        error = archive_path + ": the archive holds a directed graph";
+        return false;
     }
 
-    outfile.close();
+    n = archive.n();
+    m = (int)archive.m();
+    edges.clear();
+    edges.reserve(archive.m());
+    // for_each_arc gives every edge once, at its lower end, and stops with an error on a
+    // neighbor outside [v, n) or a list past its block
+    return archive.for_each_arc([&](int v, int u, int) { edges.push_back(Edge(v + 1, u + 1)); }, error);
+}
+
+// Converts an archive back to a DIMACS file, through write_dimacs.
+bool archive_to_dimacs(const string& archive_path, const string& dimacs_path, string& error, int threads = 1) {
+    int n, m;
+    vector<Edge> edges;
+    if (!read_dimacs_archive(archive_path, n, m, edges, error)) return false;
+    if (!write_dimacs(n, edges, dimacs_path, threads)) {
+        error = "Cannot write " + dimacs_path;
+        return false;
+    }
     return true;
 }
@@ -0,0 +1,197 @@
+#include <vector>
+#include <stdexcept>
+
+using namespace std;
+
+// Extended first-child, next-sibling tree for streams of structural updates.
+// The C++ counterpart of ExtendedFCNS_Tree in E_1_10.py, with every operation in O(1) except
+// remove_subtree:
+//  - nodes live in a pool kept as a structure of arrays (one array per field), so a node is
+//    just an index and the arrays grow only when the pool is full;
+//  - instead of a children list per node, the children are the sibling chain
+//    first_child -> next_sibling -> ... -> last_child, and last_child makes appending O(1);
+//  - removed nodes go to a free list threaded through next_sibling and are reused by new_node.
+// remove_subtree frees every node of the subtree, so it is O(size of the subtree); a node is
+// removed at most once per new_node that created it, so that is amortized O(1) per node.
+// Every slot has a live flag: an id is invalid once its subtree is removed, and using it
+// throws, until new_node hands the slot out again.
+class ExtendedFCNSTree {
+public:
+    // A range over the children of a node, following the sibling chain.
+    class ChildRange {
+    public:
+        class iterator {
+        public:
+            iterator(const ExtendedFCNSTree* tree, int v) : tree(tree), v(v) {}
+            int operator*() const { return v; }
+            iterator& operator++() {
+                v = tree->next_sibling_[v];
+                return *this;
+            }
+            bool operator!=(const iterator& other) const { return v != other.v; }
+
+        private:
+            const ExtendedFCNSTree* tree;
+            int v;
+        };
+
+        ChildRange(const ExtendedFCNSTree* tree, int first) : tree(tree), first(first) {}
+        iterator begin() const { return iterator(tree, first); }
+        iterator end() const { return iterator(tree, -1); }
+
+    private:
+        const ExtendedFCNSTree* tree;
+        int first;
+    };
+
+    // Makes room for n nodes so that the first n new_node calls do not reallocate.
+    void reserve(int n) {
+        parent_.reserve(n);
+        first_child_.reserve(n);
+        last_child_.reserve(n);
+        next_sibling_.reserve(n);
+        previous_sibling_.reserve(n);
+        num_children_.reserve(n);
+        alive_.reserve(n);
+    }
+
+    // Creates a new, unattached node and returns its id. O(1), amortized when the pool grows.
+    int new_node() {
+        int v;
+        if (free_head_ != -1) { // Fields of a freed node are already reset
+            v = free_head_;
+            free_head_ = next_sibling_[v];
+            next_sibling_[v] = -1;
+            alive_[v] = 1;
+        } else {
+            v = (int)parent_.size();
+            parent_.push_back(-1);
+            first_child_.push_back(-1);
+            last_child_.push_back(-1);
+            next_sibling_.push_back(-1);
+            previous_sibling_.push_back(-1);
+            num_children_.push_back(0);
+            alive_.push_back(1);
+        }
+        live_++;
+        return v;
+    }
+
+    // Sets the given node as the root; the tree must not have one yet. O(1).
+    void set_root(int v) {
+        check_node(v);
+        if (root_ != -1) throw logic_error("Root already set. Cannot set a new root for a non-empty tree.");
+        if (parent_[v] != -1) throw logic_error("A child node cannot become the root.");
+        root_ = v;
+    }
+
+    // Appends child as the last child of parent. O(1).
+    void add_child(int parent, int child) {
+        check_node(parent);
+        check_node(child);
+        if (parent == child) throw logic_error("Node cannot be its own parent.");
+        if (parent_[child] != -1) throw logic_error("Node already has a parent.");
+        if (child == root_) throw logic_error("The root cannot be a child.");
+
+        parent_[child] = parent;
+        int last = last_child_[parent];
+        if (last == -1) {
+            first_child_[parent] = child;
+        } else {
+            next_sibling_[last] = child;
+            previous_sibling_[child] = last;
+        }
+        last_child_[parent] = child;
+        num_children_[parent]++;
+    }
+
+    // Detaches the subtree rooted at v and returns all of its nodes to the pool, in postorder
+    // by following the links, without a stack. O(size of the subtree).
+    void remove_subtree(int v) {
+        check_node(v);
+        int p = parent_[v];
+        if (p != -1) {
+            int prev = previous_sibling_[v], next = next_sibling_[v];
+            if (prev != -1) next_sibling_[prev] = next;
+            else first_child_[p] = next;
+            if (next != -1) previous_sibling_[next] = prev;
+            else last_child_[p] = prev;
+            num_children_[p]--;
+        }
+        if (v == root_) root_ = -1;
+
+        // A node is freed after all of its children, so the links read on the way (the next
+        // sibling and parent of x, the first children below the sibling) are still intact
+        int x = leftmost_leaf(v);
+        while (true) {
+            int next = -1;
+            if (x != v) next = next_sibling_[x] != -1 ? leftmost_leaf(next_sibling_[x]) : parent_[x];
+            free_node(x);
+            if (x == v) break;
+            x = next;
+        }
+    }
+
+    // Nodes created and not removed.
+    int number_of_nodes() const { return live_; }
+    int root() const { return root_; }
+    bool is_root(int v) const { return v >= 0 && v == root_; }
+
+    int parent(int v) const { check_node(v); return parent_[v]; }
+    int first_child(int v) const { check_node(v); return first_child_[v]; }
+    int last_child(int v) const { check_node(v); return last_child_[v]; }
+    int next_sibling(int v) const { check_node(v); return next_sibling_[v]; }
+    int previous_sibling(int v) const { check_node(v); return previous_sibling_[v]; }
+    int number_of_children(int v) const { check_node(v); return num_children_[v]; }
+    bool is_leaf(int v) const { check_node(v); return num_children_[v] == 0; }
+
+    bool is_first_child(int v) const {
+        check_node(v);
+        return parent_[v] != -1 && first_child_[parent_[v]] == v;
+    }
+
+    bool is_last_child(int v) const {
+        check_node(v);
+        return parent_[v] != -1 && last_child_[parent_[v]] == v;
+    }
+
+    // The children of v in insertion order, without copying. O(1) to obtain.
+    ChildRange children(int v) const {
+        check_node(v);
+        return ChildRange(this, first_child_[v]);
+    }
+
+private:
+    // Node fields, one array each
+    vector<int> parent_;
+    vector<int> first_child_;
+    vector<int> last_child_;
+    vector<int> next_sibling_; // Also links the free list
+    vector<int> previous_sibling_;
+    vector<int> num_children_;
+    vector<char> alive_; // 0 once the node is removed, until new_node reuses it
+
+    int root_ = -1;
+    int free_head_ = -1;
+    int live_ = 0;
+
+    void check_node(int v) const {
+        if (v < 0 || v >= (int)parent_.size()) throw out_of_range("Node ID out of bounds.");
+        if (!alive_[v]) throw logic_error("Node ID refers to a removed node.");
+    }
+
+    int leftmost_leaf(int v) const {
+        while (first_child_[v] != -1) v = first_child_[v];
+        return v;
+    }
+
+    // Resets the fields of v and puts it on the free list.
+    void free_node(int v) {
+        parent_[v] = first_child_[v] = last_child_[v] = previous_sibling_[v] = -1;
+        num_children_[v] = 0;
+        alive_[v] = 0;
+        next_sibling_[v] = free_head_;
+        free_head_ = v;
+        live_--;
+    }
+};
@@ -1,11 +1,15 @@
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
-#include <unordered_map>
-#include <cassert>
 #include <algorithm>
+#include <cstring>
+#include <string_view>
+#include "../../common/graph_archive.h" // Compressed graph archives (.nga)
+#include "../../common/label_pool.h"  // Interned vertex labels
+#include "../../common/mapped_file.h" // Read-only mapping of the input file
+#include "../../common/sgb_scan.h"    // GraphBase section scanner
+#include "../../common/text_writer.h" // Buffered output of write_sgb
 
 using namespace std;
 
@@ -17,127 +21,156 @@ struct Edge {
 
 class SGBGraph {
 public:
-    vector<string> vertices;         // Vertex labels
+    vector<string> vertices;         // Vertex labels, unless intern_labels is set
     vector<Edge> edges;              // List of edges (src, tgt, label)
 
-    void read_sgb(const string& filename) {
-        ifstream file(filename);
-        if (!file) {
-            cerr << "Failed to open file." << endl;
-            return;
-        }
-
-        vector<string> lines;
-        string line;
-        while (getline(file, line)) {
-            if (!line.empty()) {
-                lines.push_back(line);
-            }
-        }
-
-        assert(lines[0].rfind("* GraphBase", 0) == 0);
-
-        int v_start = -1, a_start = -1, checksum_idx = -1;
-        for (int i = 0; i < lines.size(); ++i) {
-            if (lines[i] == "* Vertices") v_start = i + 1;
-            else if (lines[i] == "* Arcs") a_start = i + 1;
-            else if (lines[i].rfind("* Checksum", 0) == 0) checksum_idx = i;
-        }
-
-        assert(v_start != -1 && a_start != -1 && checksum_idx != -1);
-
+    // Label storage mode for graphs with many labelled vertices: with intern_labels set,
+    // read_sgb leaves vertices empty and stores every distinct label once in the pool of
+    // common/label_pool.h, the label of vertex v being labels[vertex_label[v]].
+    // vertex_count() and label(v) work in both modes.
+    bool intern_labels = false;
+    LabelPool labels;
+    vector<int> vertex_label;
+
+    int vertex_count() const { return intern_labels ? (int)vertex_label.size() : (int)vertices.size(); }
+    string_view label(int v) const { return intern_labels ? labels[vertex_label[v]] : string_view(vertices[v]); }
+
+    // Reads a GraphBase file with scan_sgb of common/sgb_scan.h, in one pass over its memory
+    // mapping, and follows the arc chain of every vertex by indexing, in chain order, as
+    // before. On failure error holds the reason, with the byte offset of a malformed line,
+    // and the graph is left empty.
+    bool read_sgb(const string& filename, string& error) {
         vertices.clear();
-        vector<int> vertex_edges;
-
-        for (int i = v_start; i < a_start - 1; ++i) {
-            stringstream ss(lines[i]);
-            string label;
-            int Ai;
-            getline(ss, label, ',');
-            ss >> Ai;
-            vertices.push_back(label);
-            vertex_edges.push_back(Ai);
-        }
-
-        vector<int> edge_targets, edge_nexts, edge_labels;
-
-        for (int i = a_start; i < checksum_idx; ++i) {
-            stringstream ss(lines[i]);
-            string tmp;
-            int tgt, Ai, label;
-            ss >> tmp >> tgt; // read "V j"
-            ss.ignore(); // skip comma
-            ss >> Ai;
-            ss.ignore();
-            ss >> label;
-            edge_targets.push_back(tgt);
-            edge_nexts.push_back(Ai);
-            edge_labels.push_back(label);
+        labels.clear();
+        vertex_label.clear();
+        edges.clear();
+        MappedFile file;
+        if (!file.open(filename, error)) return false;
+
+        SgbArcs arcs;
+        auto add_vertex = [&](string_view name) {
+            if (intern_labels) vertex_label.push_back(labels.intern(name));
+            else vertices.emplace_back(name);
+        };
+        auto add_arc = [&](int v, int tgt, int label) { edges.push_back({v, tgt, label}); };
+        bool ok = scan_sgb(file.data(), file.size(), add_vertex, arcs, error);
+        if (ok) {
+            edges.reserve(arcs.target.size());
+            ok = for_each_sgb_arc(arcs, add_arc, error);
         }
-
-        unordered_map<int, tuple<int, int, int>> edge_map;
-        for (int i = 0; i < edge_targets.size(); ++i) {
-            edge_map[i + 1] = make_tuple(edge_targets[i], edge_nexts[i], edge_labels[i]);
+        if (!ok) {
+            error = filename + ": " + error;
+            vertices.clear();
+            labels.clear();
+            vertex_label.clear();
+            edges.clear();
         }
+        return ok;
+    }
 
-        edges.clear();
-        for (int v = 0; v < vertex_edges.size(); ++v) {
-            int i = vertex_edges[v];
-            while (i != 0) {
-                auto [tgt, nxt, lbl] = edge_map[i];
-                edges.push_back({v, tgt, lbl});
-                i = nxt;
-            }
-        }
+    void read_sgb(const string& filename) {
+        string error;
+        if (!read_sgb(filename, error)) cerr << error << endl;
     }
 
-    void write_sgb(const string& filename) {
-        ofstream file(filename);
-        int n = vertices.size();
+    // Writes the graph through the buffered writer of common/text_writer.h in O(n + m).
+    // The arcs are bucketed by source with one stable counting pass, so arc k + 1 (ids are
+    // 1-based) is the k-th edge in (source, edge index) order, the chain of every vertex is
+    // a run of consecutive ids, and the arcs are written in id order, the order the reader
+    // numbers them in. The file only depends on the graph. threads > 1 formats the vertex
+    // and arc lines in parallel, and the file is the same in every mode.
+    void write_sgb(const string& filename, int threads = 1) {
+        TextWriter file;
+        file.open(filename);
+        int n = vertex_count();
         int m = edges.size();
 
         file << "* GraphBase graph (utiltypes ...," << n << "," << m << ")\n";
         file << "Generated by SGBGraph\n";
         file << "* Vertices\n";
 
-        int edge_idx = 1;
-        unordered_map<int, tuple<int, int, int>> edge_chain;
-        unordered_map<int, int> vertex_first_edge;
+        // Arcs of vertex v are arc_edge[first[v] .. first[v + 1]); edges whose source is not
+        // a vertex have no arc
+        vector<int> first(n + 1, 0);
+        for (const Edge& e : edges) {
+            if (e.src >= 0 && e.src < n) first[e.src + 1]++;
+        }
+        for (int v = 0; v < n; ++v) first[v + 1] += first[v];
+        vector<int> arc_edge(first[n]);
+        vector<int> next_slot(first.begin(), first.end() - 1);
+        for (int i = 0; i < m; ++i) {
+            if (edges[i].src >= 0 && edges[i].src < n) arc_edge[next_slot[edges[i].src]++] = i;
+        }
+        vector<int>().swap(next_slot);
 
-        for (int v = 0; v < n; ++v) {
-            vector<pair<int, Edge>> out_edges;
-            for (int i = 0; i < edges.size(); ++i) {
-                if (edges[i].src == v) {
-                    out_edges.emplace_back(i, edges[i]);
-                }
-            }
+        write_lines(file, n, threads, [&](size_t v, TextBuffer& line) {
+            int first_arc = first[v] < first[v + 1] ? first[v] + 1 : 0;
+            line << label(v) << "," << first_arc << ",0,0\n";
+        });
 
-            if (out_edges.empty()) {
-                vertex_first_edge[v] = 0;
-                continue;
-            }
+        file << "* Arcs\n";
+        write_lines(file, arc_edge.size(), threads, [&](size_t k, TextBuffer& line) {
+            const Edge& e = edges[arc_edge[k]];
+            int next_arc = (int)k + 1 < first[e.src + 1] ? (int)k + 2 : 0;
+            line << "V " << e.tgt << "," << next_arc << "," << e.label << ",0\n";
+        });
 
-            int first_i = edge_idx;
-            vertex_first_edge[v] = first_i;
+        file << "* Checksum 0\n";
+    }
 
-            for (int i = 0; i < out_edges.size(); ++i) {
-                int curr_id = edge_idx++;
-                int next_id = (i < out_edges.size() - 1) ? edge_idx : 0;
-                Edge& e = out_edges[i].second;
-                edge_chain[curr_id] = make_tuple(e.tgt, next_id, e.label);
+    // Writes the graph to the compressed archive of common/graph_archive.h: a directed
+    // archive with the edge labels as arc labels and the vertex labels. Within every source
+    // the arcs are stored sorted by (target, label), so read_archive gives the edges sorted.
+    bool write_archive(const string& path, string& error) const {
+        int n = vertex_count();
+        vector<long long> offset(n + 1, 0);
+        for (const Edge& e : edges) {
+            if (e.src < 0 || e.src >= n) {
+                error = path + ": edge source " + to_string(e.src) + " is not a vertex";
+                return false;
             }
+            offset[e.src + 1]++;
         }
-
-        for (int v = 0; v < n; ++v) {
-            file << vertices[v] << "," << vertex_first_edge[v] << ",0,0\n";
+        for (int v = 0; v < n; ++v) offset[v + 1] += offset[v];
+        vector<int> target(edges.size()), arc_label(edges.size());
+        vector<long long> next_slot(offset.begin(), offset.end() - 1);
+        for (const Edge& e : edges) {
+            long long k = next_slot[e.src]++;
+            target[k] = e.tgt;
+            arc_label[k] = e.label;
         }
+        vector<long long>().swap(next_slot);
 
-        file << "* Arcs\n";
-        for (const auto& [i, tup] : edge_chain) {
-            auto [tgt, nxt, lbl] = tup;
-            file << "V " << tgt << "," << nxt << "," << lbl << ",0\n";
-        }
+        vector<string_view> names(n);
+        for (int v = 0; v < n; ++v) names[v] = label(v);
+        return write_graph_archive(path, n, edges.size(), false, offset, target, arc_label, names, error);
+    }
 
-        file << "* Checksum 0\n";
+    // Reads an archive written by write_archive (or any archive; missing labels are empty).
+    // A symmetric archive stores every edge once, so both of its arcs are added back.
+    bool read_archive(const string& path, string& error) {
+        vertices.clear();
+        labels.clear();
+        vertex_label.clear();
+        edges.clear();
+        GraphArchive archive;
+        if (!archive.open(path, error)) return false;
+
+        auto add_vertex = [&](int, string_view name) {
+            if (intern_labels) vertex_label.push_back(labels.intern(name));
+            else vertices.emplace_back(name);
+        };
+        if (archive.has_vertex_labels()) {
+            if (!archive.for_each_vertex_label(add_vertex, error)) return false;
+        } else {
+            for (int v = 0; v < archive.n(); ++v) add_vertex(v, string_view());
+        }
+        bool symmetric = archive.symmetric();
+        edges.reserve(symmetric ? 2 * archive.arcs() : archive.arcs());
+        // Every target is checked against n, so the edges never name a missing vertex
+        return archive.for_each_arc([&](int v, int u, int lbl) {
+            edges.push_back({v, u, lbl});
+            if (symmetric) edges.push_back({u, v, lbl});
+        }, error);
     }
 };
@@ -0,0 +1,228 @@
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace std;
+
+// Snapshot types, with the same layout as in Project_4/BT4/cpp/represent_general.cpp
+struct AdjacencyMatrix {
+    vector<vector<int>> matrix; // Stores count of edges between vertices
+    int n;
+};
+
+struct AdjacencyList {
+    vector<vector<int>> adj;
+    int n;
+};
+
+struct ExtendedAdjacencyList {
+    vector<vector<int>> incoming; // Stores indices to 'edges'
+    vector<vector<int>> outgoing; // Stores indices to 'edges'
+    vector<pair<int, int>> edges; // Stores all individual edge instances (u,v)
+    int n, m;
+};
+
+struct AdjacencyMap {
+    // For each vertex 'u', stores a list of pairs: {neighbor_v, canonical_edge_tuple (min(u,v), max(u,v))}
+    unordered_map<int, vector<pair<int, pair<int, int>>>> outgoing;
+    unordered_map<int, vector<pair<int, pair<int, int>>>> incoming;
+    int n;
+    int m;
+};
+
+// Dynamic undirected general graph (loops and repeated edges allowed) for streams of updates.
+// The C++ counterpart of the operations in E_1_5.py, but with every update in O(1):
+//  - edges live in a dense slot array; deleting an edge moves the last slot into the hole
+//    (swap-remove), so edge ids are the slot indices and stay dense;
+//  - every vertex keeps the slots incident to it, and every slot remembers its position in
+//    those lists, so it can be swap-removed from them as well;
+//  - a hash index from the canonical pair (min(u,v), max(u,v)) to its slots gives O(1) edge(u,v).
+// An edge id stays valid until the next del_edge/del_vertex.
+class DynamicGraph {
+public:
+    // Inserts a new isolated vertex and returns its index. Amortized O(1).
+    int new_vertex() {
+        incident.emplace_back();
+        return (int)incident.size() - 1;
+    }
+
+    // Inserts a new edge between u and v and returns its id. Amortized O(1).
+    int new_edge(int u, int v) {
+        check_vertex(u);
+        check_vertex(v);
+        int id = (int)slots.size();
+        Slot s;
+        s.u = u;
+        s.v = v;
+        s.pos_u = (int)incident[u].size();
+        incident[u].push_back(id);
+        if (u != v) { // A loop is incident to its vertex once
+            s.pos_v = (int)incident[v].size();
+            incident[v].push_back(id);
+        } else {
+            s.pos_v = s.pos_u;
+        }
+        vector<int>& same = pair_index[pair_key(u, v)];
+        s.pos_pair = (int)same.size();
+        same.push_back(id);
+        slots.push_back(s);
+        return id;
+    }
+
+    // Deletes one edge between u and v; returns false if there is none. O(1).
+    bool del_edge(int u, int v) {
+        int id = edge(u, v);
+        if (id == -1) return false;
+        del_edge_id(id);
+        return true;
+    }
+
+    // Deletes the edge with the given id. O(1).
+    void del_edge_id(int id) {
+        if (id < 0 || id >= (int)slots.size()) throw out_of_range("Edge id out of bounds.");
+        Slot s = slots[id];
+        remove_incident(s.u, s.pos_u);
+        if (s.u != s.v) remove_incident(s.v, s.pos_v);
+        remove_from_pair(s);
+
+        // Move the last slot into the hole and repoint everything that referred to it
+        int last = (int)slots.size() - 1;
+        if (id != last) {
+            Slot& moved = slots[id];
+            moved = slots[last];
+            incident[moved.u][moved.pos_u] = id;
+            incident[moved.v][moved.pos_v] = id;
+            pair_index[pair_key(moved.u, moved.v)][moved.pos_pair] = id;
+        }
+        slots.pop_back();
+    }
+
+    // Deletes all edges incident to v; the vertex itself stays (as in E_1_5.py). O(deg(v)).
+    void del_vertex(int v) {
+        check_vertex(v);
+        while (!incident[v].empty()) del_edge_id(incident[v].back());
+    }
+
+    // Id of some edge between u and v, or -1 if they are not adjacent. O(1) expected.
+    int edge(int u, int v) const {
+        auto it = pair_index.find(pair_key(u, v));
+        return it == pair_index.end() || it->second.empty() ? -1 : it->second.back();
+    }
+
+    bool adjacent(int u, int v) const { return edge(u, v) != -1; }
+
+    // Number of edges between u and v. O(1) expected.
+    int multiplicity(int u, int v) const {
+        auto it = pair_index.find(pair_key(u, v));
+        return it == pair_index.end() ? 0 : (int)it->second.size();
+    }
+
+    int number_of_vertices() const { return (int)incident.size(); }
+    int number_of_edges() const { return (int)slots.size(); }
+    pair<int, int> endpoints(int id) const { return {slots[id].u, slots[id].v}; }
+    const vector<int>& incident_edges(int v) const { return incident[v]; }
+
+    int opposite(int v, int id) const {
+        return slots[id].u == v ? slots[id].v : slots[id].u;
+    }
+
+    // ========== SNAPSHOTS ==========
+    // Each snapshot is a single pass over the slots and incidence lists that are already
+    // kept up to date; no counting maps or sorting as in the xToY conversions.
+
+    ExtendedAdjacencyList to_extended() const {
+        ExtendedAdjacencyList ext;
+        ext.n = number_of_vertices();
+        ext.m = number_of_edges();
+        ext.edges.reserve(ext.m);
+        for (const Slot& s : slots) ext.edges.push_back({s.u, s.v});
+        ext.outgoing = incident; // For undirected graphs every incident edge is both
+        ext.incoming = incident;
+        return ext;
+    }
+
+    AdjacencyList to_list() const {
+        AdjacencyList list;
+        list.n = number_of_vertices();
+        list.adj.resize(list.n);
+        for (int v = 0; v < list.n; ++v) {
+            list.adj[v].reserve(incident[v].size());
+            for (int id : incident[v]) list.adj[v].push_back(opposite(v, id));
+        }
+        return list;
+    }
+
+    AdjacencyMatrix to_matrix() const {
+        AdjacencyMatrix matrix;
+        matrix.n = number_of_vertices();
+        matrix.matrix.assign(matrix.n, vector<int>(matrix.n, 0));
+        for (const Slot& s : slots) {
+            matrix.matrix[s.u][s.v]++;
+            if (s.u != s.v) matrix.matrix[s.v][s.u]++;
+        }
+        return matrix;
+    }
+
+    AdjacencyMap to_map() const {
+        AdjacencyMap map;
+        map.n = number_of_vertices();
+        map.m = number_of_edges();
+        map.outgoing.reserve(map.n);
+        for (int v = 0; v < map.n; ++v) {
+            if (incident[v].empty()) continue;
+            vector<pair<int, pair<int, int>>>& entries = map.outgoing[v];
+            entries.reserve(incident[v].size());
+            for (int id : incident[v]) {
+                const Slot& s = slots[id];
+                entries.push_back({opposite(v, id), {min(s.u, s.v), max(s.u, s.v)}});
+            }
+        }
+        map.incoming = map.outgoing;
+        return map;
+    }
+
+private:
+    struct Slot {
+        int u, v;
+        int pos_u, pos_v; // Positions of this slot in incident[u] and incident[v]
+        int pos_pair;     // Position in pair_index[pair_key(u, v)]
+    };
+
+    vector<Slot> slots;
+    vector<vector<int>> incident;
+    unordered_map<uint64_t, vector<int>> pair_index;
+
+    static uint64_t pair_key(int u, int v) {
+        if (u > v) swap(u, v);
+        return ((uint64_t)(uint32_t)u << 32) | (uint32_t)v;
+    }
+
+    void check_vertex(int v) const {
+        if (v < 0 || v >= (int)incident.size()) throw out_of_range("Vertex index out of bounds.");
+    }
+
+    // Swap-removes position pos from incident[v], fixing the position of the slot moved there.
+    void remove_incident(int v, int pos) {
+        vector<int>& list = incident[v];
+        int moved = list.back();
+        list[pos] = moved;
+        list.pop_back();
+        if (pos == (int)list.size()) return; // Removed the last entry
+        Slot& s = slots[moved];
+        if (s.u == v) s.pos_u = pos;
+        if (s.v == v) s.pos_v = pos;
+    }
+
+    void remove_from_pair(const Slot& s) {
+        auto it = pair_index.find(pair_key(s.u, s.v));
+        vector<int>& same = it->second;
+        int moved = same.back();
+        same[s.pos_pair] = moved;
+        same.pop_back();
+        if (s.pos_pair < (int)same.size()) slots[moved].pos_pair = s.pos_pair;
+        if (same.empty()) pair_index.erase(it);
+    }
+};
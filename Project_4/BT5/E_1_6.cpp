@@ -1,20 +1,52 @@
 #include <vector>
 #include <utility> // For std::pair
 #include <iostream> // For std::cout, std::endl
-#include <functional> // For std::function (optional, if using lambda for recursion)
+#include <algorithm> // For std::next_permutation
 
-// Forward declaration for the recursive helper function
-void findPerfectMatchingsRecursive(
-    int l_idx,                                    // Current left vertex (absolute ID) to match
-    int n,                                        // Size of each partition (p or q)
-    std::vector<std::pair<int, int>>& currentMatching, // Edges for the current matching
-    std::vector<bool>& usedRightVertices,         // Tracks if right vertices (relative index) are used
-    std::vector<std::vector<std::pair<int, int>>>& allMatchings // Stores all found perfect matchings
-);
+/**
+ * @brief Visits every perfect matching of the complete bipartite graph K_p,q, one at a time.
+ * A perfect matching exists only if p == q = n, and then there are n! of them.
+ *
+ * Left vertices are 0 to n-1 and right vertices are n to 2n-1. A perfect matching is a
+ * permutation: match[i] is the relative index (0 to n-1) of the right vertex matched to
+ * left vertex i, so its edges are (i, n + match[i]). The matchings are visited in the
+ * lexicographic order of their permutations, which is the order of the original recursive
+ * search, and are never stored: the only memory is the permutation itself, O(n), so the
+ * enumeration can count, sample or stream matchings for any n that time allows.
+ *
+ * @param p Number of vertices in the first partition.
+ * @param q Number of vertices in the second partition.
+ * @param visit Called as visit(match) with each matching; match is reused for the next one,
+ * so it is only valid during the call. Returns false to stop the enumeration early.
+ * @return The number of matchings visited.
+ */
+template <typename Visitor>
+long long forEachPerfectMatchingKpq(int p, int q, Visitor visit) {
+    // Perfect matching requires equal partition sizes
+    if (p != q || p < 0) {
+        return 0;
+    }
+
+    int n = p; // Since p == q, n represents the size of each partition
+    std::vector<int> match(n);
+    for (int i = 0; i < n; ++i) {
+        match[i] = i; // First permutation: left vertex i takes right vertex n + i
+    }
+
+    long long count = 0;
+    do {
+        ++count;
+        if (!visit(static_cast<const std::vector<int>&>(match))) {
+            break;
+        }
+    } while (std::next_permutation(match.begin(), match.end()));
+    return count;
+}
 
 /**
  * @brief Enumerates all perfect matchings in a complete bipartite graph K_p,q.
- * A perfect matching exists only if p == q.
+ * Collects the matchings of forEachPerfectMatchingKpq, which takes n! * n pairs of memory;
+ * use forEachPerfectMatchingKpq directly for anything but small n.
  *
  * @param p Number of vertices in the first partition.
  * @param q Number of vertices in the second partition.
@@ -25,151 +57,61 @@ void findPerfectMatchingsRecursive(
  */
 std::vector<std::vector<std::pair<int, int>>> enumeratePerfectMatchingsKpq(int p, int q) {
     std::vector<std::vector<std::pair<int, int>>> allMatchings;
-
-    // Perfect matching requires equal partition sizes
-    if (p != q) {
-        return allMatchings; // No perfect matching if p != q
-    }
-
-    int n = p; // Since p == q, n represents the size of each partition
-
-    std::vector<std::pair<int, int>> currentMatching;
-    // usedRightVertices tracks if a vertex in the RIGHT partition (relative index 0 to n-1) is used
-    std::vector<bool> usedRightVertices(n, false); 
-
-    // Start the recursive process from the first vertex in the left partition (index 0)
-    findPerfectMatchingsRecursive(0, n, currentMatching, usedRightVertices, allMatchings);
+    forEachPerfectMatchingKpq(p, q, [&](const std::vector<int>& match) {
+        std::vector<std::pair<int, int>> matching;
+        matching.reserve(match.size());
+        for (size_t i = 0; i < match.size(); ++i) {
+            matching.push_back({(int)i, p + match[i]});
+        }
+        allMatchings.push_back(matching);
+        return true;
+    });
     return allMatchings;
 }
 
 /**
- * @brief Recursive helper function to find perfect matchings.
- *
- * @param l_idx Current left vertex (absolute ID) to match.
- * @param n Size of each partition.
- * @param currentMatching Reference to the vector storing the current matching being built.
- * @param usedRightVertices Reference to the boolean vector tracking used right vertices.
- * @param allMatchings Reference to the vector storing all found perfect matchings.
+ * @brief Prints every perfect matching of K_p,q as it is found, then the total.
+ * Nothing is collected, so the output starts at once and the memory stays O(n).
  */
-void findPerfectMatchingsRecursive(
-    int l_idx, 
-    int n, 
-    std::vector<std::pair<int, int>>& currentMatching, 
-    std::vector<bool>& usedRightVertices, 
-    std::vector<std::vector<std::pair<int, int>>>& allMatchings
-) {
-    // Base case: If all left vertices have been matched, a perfect matching is found
-    if (l_idx == n) {
-        allMatchings.push_back(currentMatching); // Add a copy of the current matching
-        return;
-    }
-
-    // Iterate through all vertices in the right partition to find a match for L[l_idx]
-    for (int r_relative_idx = 0; r_relative_idx < n; ++r_relative_idx) {
-        // If the current right vertex is not yet used
-        if (!usedRightVertices[r_relative_idx]) {
-            usedRightVertices[r_relative_idx] = true; // Mark as used
-            
-            // Form the edge using absolute vertex IDs
-            // Left vertex ID is l_idx
-            // Right vertex ID is (n + r_relative_idx) because right partition starts after left
-            std::pair<int, int> edge = {l_idx, n + r_relative_idx}; 
-            currentMatching.push_back(edge);
-
-            // Recursively call for the next left vertex
-            findPerfectMatchingsRecursive(l_idx + 1, n, currentMatching, usedRightVertices, allMatchings);
-
-            // Backtrack: Undo the choice for the current L[l_idx]
-            currentMatching.pop_back();
-            usedRightVertices[r_relative_idx] = false;
+void printPerfectMatchingsKpq(int p, int q) {
+    std::cout << "Enumerating perfect matchings for K_" << p << "," << q << ":" << std::endl;
+    long long shown = 0;
+    long long total = forEachPerfectMatchingKpq(p, q, [&](const std::vector<int>& match) {
+        std::cout << "  Matching " << ++shown << ": {";
+        for (size_t i = 0; i < match.size(); ++i) {
+            std::cout << "(" << i << "," << p + match[i] << ")";
+            if (i + 1 < match.size()) {
+                std::cout << ", ";
+            }
         }
+        std::cout << "}" << std::endl;
+        return true;
+    });
+    if (total == 0) {
+        std::cout << "No perfect matchings found." << std::endl;
+    } else {
+        std::cout << "Total perfect matchings: " << total << "\n" << std::endl;
     }
 }
 
 int main() {
     // Example 1: K_3,3 (expect 3! = 6 perfect matchings)
-    int p1 = 3;
-    int q1 = 3;
-    std::cout << "Enumerating perfect matchings for K_" << p1 << "," << q1 << ":" << std::endl;
-    std::vector<std::vector<std::pair<int, int>>> matchings1 = enumeratePerfectMatchingsKpq(p1, q1);
-    if (matchings1.empty()) {
-        std::cout << "No perfect matchings found." << std::endl;
-    } else {
-        for (size_t i = 0; i < matchings1.size(); ++i) {
-            std::cout << "  Matching " << i + 1 << ": {";
-            for (size_t j = 0; j < matchings1[i].size(); ++j) {
-                std::cout << "(" << matchings1[i][j].first << "," << matchings1[i][j].second << ")";
-                if (j < matchings1[i].size() - 1) {
-                    std::cout << ", ";
-                }
-            }
-            std::cout << "}" << std::endl;
-        }
-        std::cout << "Total perfect matchings: " << matchings1.size() << "\n" << std::endl;
-    }
+    printPerfectMatchingsKpq(3, 3);
 
     // Example 2: K_2,2 (expect 2! = 2 perfect matchings)
-    int p2 = 2;
-    int q2 = 2;
-    std::cout << "Enumerating perfect matchings for K_" << p2 << "," << q2 << ":" << std::endl;
-    std::vector<std::vector<std::pair<int, int>>> matchings2 = enumeratePerfectMatchingsKpq(p2, q2);
-    if (matchings2.empty()) {
-        std::cout << "No perfect matchings found." << std::endl;
-    } else {
-        for (size_t i = 0; i < matchings2.size(); ++i) {
-            std::cout << "  Matching " << i + 1 << ": {";
-            for (size_t j = 0; j < matchings2[i].size(); ++j) {
-                std::cout << "(" << matchings2[i][j].first << "," << matchings2[i][j].second << ")";
-                if (j < matchings2[i].size() - 1) {
-                    std::cout << ", ";
-                }
-            }
-            std::cout << "}" << std::endl;
-        }
-        std::cout << "Total perfect matchings: " << matchings2.size() << "\n" << std::endl;
-    }
+    printPerfectMatchingsKpq(2, 2);
 
     // Example 3: K_2,3 (expect 0 perfect matchings)
-    int p3 = 2;
-    int q3 = 3;
-    std::cout << "Enumerating perfect matchings for K_" << p3 << "," << q3 << ":" << std::endl;
-    std::vector<std::vector<std::pair<int, int>>> matchings3 = enumeratePerfectMatchingsKpq(p3, q3);
-    if (matchings3.empty()) {
-        std::cout << "No perfect matchings found." << std::endl;
-    } else {
-        for (size_t i = 0; i < matchings3.size(); ++i) {
-            std::cout << "  Matching " << i + 1 << ": {";
-            for (size_t j = 0; j < matchings3[i].size(); ++j) {
-                std::cout << "(" << matchings3[i][j].first << "," << matchings3[i][j].second << ")";
-                if (j < matchings3[i].size() - 1) {
-                    std::cout << ", ";
-                }
-            }
-            std::cout << "}" << std::endl;
-        }
-        std::cout << "Total perfect matchings: " << matchings3.size() << "\n" << std::endl;
-    }
+    printPerfectMatchingsKpq(2, 3);
 
     // Example 4: K_0,0 (expect 1 perfect matching - empty set)
-    int p4 = 0;
-    int q4 = 0;
-    std::cout << "Enumerating perfect matchings for K_" << p4 << "," << q4 << ":" << std::endl;
-    std::vector<std::vector<std::pair<int, int>>> matchings4 = enumeratePerfectMatchingsKpq(p4, q4);
-    if (matchings4.empty()) {
-        std::cout << "No perfect matchings found." << std::endl;
-    } else {
-        for (size_t i = 0; i < matchings4.size(); ++i) {
-            std::cout << "  Matching " << i + 1 << ": {";
-            for (size_t j = 0; j < matchings4[i].size(); ++j) {
-                std::cout << "(" << matchings4[i][j].first << "," << matchings4[i][j].second << ")";
-                if (j < matchings4[i].size() - 1) {
-                    std::cout << ", ";
-                }
-            }
-            std::cout << "}" << std::endl;
-        }
-        std::cout << "Total perfect matchings: " << matchings4.size() << "\n" << std::endl;
-    }
+    printPerfectMatchingsKpq(0, 0);
+
+    // Example 5: K_11,11 counted without storing a matching (expect 11! = 39916800);
+    // collecting them with enumeratePerfectMatchingsKpq would take gigabytes
+    int n5 = 11;
+    long long count5 = forEachPerfectMatchingKpq(n5, n5, [](const std::vector<int>&) { return true; });
+    std::cout << "Counting perfect matchings for K_" << n5 << "," << n5 << ": " << count5 << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,7 +1,11 @@
 #include <iostream>
 #include <vector>
+#include <string>
 #include <queue>
 #include <algorithm>
+
+#include "../../../common/tree_relabel.h"
+
 using namespace std;
 
 struct NodeInfo {
@@ -43,15 +47,8 @@ void dfs_height(int u, const vector<vector<int>> &tree, int depth, vector<int> &
     heights[u] = max_child_height + 1;
 }
 
-// Duyệt bottom-up: in các đỉnh theo thứ tự không giảm của chiều cao,
-// cùng chiều cao thì theo thứ tự không giảm của độ sâu, cùng chiều cao và độ sâu thì trái sang phải
-void bottom_up(const vector<vector<int>> &tree, int root, int n) {
-    vector<int> depths(n + 1), heights(n + 1);
-    dfs_height(root, tree, 0, depths, heights);
-    vector<NodeInfo> nodes;
-    for (int u = 1; u <= n; ++u) {
-        nodes.emplace_back(u, depths[u], heights[u]);
-    }
+// In các đỉnh theo thứ tự bottom-up (sắp xếp theo chiều cao, độ sâu, số hiệu)
+void print_bottom_up(vector<NodeInfo> &nodes) {
     // Sắp xếp theo height tăng dần, depth tăng dần, u tăng dần
     sort(nodes.begin(), nodes.end(), [](const NodeInfo &a, const NodeInfo &b) {
         if (a.height != b.height) return a.height < b.height;
@@ -71,10 +68,37 @@ void bottom_up(const vector<vector<int>> &tree, int root, int n) {
     cout << '\n';
 }
 
-int main() {
+// Duyệt bottom-up: in các đỉnh theo thứ tự không giảm của chiều cao,
+// cùng chiều cao thì theo thứ tự không giảm của độ sâu, cùng chiều cao và độ sâu thì trái sang phải
+void bottom_up(const vector<vector<int>> &tree, int root, int n) {
+    vector<int> depths(n + 1), heights(n + 1);
+    dfs_height(root, tree, 0, depths, heights);
+    vector<NodeInfo> nodes;
+    for (int u = 1; u <= n; ++u) {
+        nodes.emplace_back(u, depths[u], heights[u]);
+    }
+    print_bottom_up(nodes);
+}
+
+// Như bottom_up nhưng trên cây đã đánh số lại theo preorder: độ sâu và chiều cao được tính bằng
+// hai lần quét tuần tự (cha luôn đứng trước con) thay cho DFS đệ quy
+void bottom_up_relabeled(const RelabeledTree &t) {
+    vector<int> depths = node_depths(t), heights = node_heights(t);
+    vector<NodeInfo> nodes;
+    nodes.reserve(t.n);
+    for (int u = 0; u < t.n; ++u) {
+        nodes.emplace_back(t.original[u], depths[u], heights[u]);
+    }
+    print_bottom_up(nodes);
+}
+
+int main(int argc, char *argv[]) {
+    // --relabel: duyệt trên cây đã đánh số lại, kết quả in ra giống hệt
+    bool use_relabel = argc > 1 && string(argv[1]) == "--relabel";
     int n, root;
     vector<vector<int>> tree;
     read_tree(n, tree, root);
-    bottom_up(tree, root, n);
+    if (use_relabel) bottom_up_relabeled(relabel_tree(tree, root, RelabelOrder::PREORDER));
+    else bottom_up(tree, root, n);
     return 0;
 }
@@ -1,5 +1,9 @@
 #include <iostream>
 #include <vector>
+#include <string>
+
+#include "../../../common/tree_relabel.h"
+
 using namespace std;
 
 // Đọc cây từ input dạng danh sách cha-con
@@ -31,12 +35,25 @@ void postorder(int u, const vector<vector<int>> &tree) {
     cout << u << ' ';
 }
 
-int main() {
+// Duyệt postorder trên cây đã đánh số lại theo preorder, không đệ quy:
+// vị trí của u trong postorder là u - depth[u] + size[u] - 1 (các đỉnh đứng trước u trong
+// postorder là các đỉnh đứng trước u trong preorder trừ đi tổ tiên của u, cộng với cây con của u)
+void postorder_relabeled(const RelabeledTree &t) {
+    vector<int> depth = node_depths(t), size = subtree_sizes(t);
+    vector<int> order(t.n);
+    for (int u = 0; u < t.n; ++u) order[u - depth[u] + size[u] - 1] = t.original[u];
+    for (int u : order) cout << u << ' ';
+}
+
+int main(int argc, char *argv[]) {
+    // --relabel: duyệt trên cây đã đánh số lại, kết quả in ra giống hệt
+    bool use_relabel = argc > 1 && string(argv[1]) == "--relabel";
     int n, root;
     vector<vector<int>> tree;
     read_tree(n, tree, root);
     cout << "Thu tu duyet postorder: ";
-    postorder(root, tree);
+    if (use_relabel) postorder_relabeled(relabel_tree(tree, root, RelabelOrder::PREORDER));
+    else postorder(root, tree);
     cout << '\n';
     return 0;
 }
@@ -1,5 +1,9 @@
 #include <iostream>
 #include <vector>
+#include <string>
+
+#include "../../../common/tree_relabel.h"
+
 using namespace std;
 
 // Đọc cây từ input dạng danh sách cha-con
@@ -29,12 +33,20 @@ void preorder(int u, const vector<vector<int>> &tree) {
     for (int v : tree[u]) preorder(v, tree);
 }
 
-int main() {
+// Duyệt preorder trên cây đã đánh số lại theo preorder: thứ tự duyệt chính là 0, 1, ..., n-1
+void preorder_relabeled(const RelabeledTree &t) {
+    for (int u = 0; u < t.n; ++u) cout << t.original[u] << ' ';
+}
+
+int main(int argc, char *argv[]) {
+    // --relabel: duyệt trên cây đã đánh số lại, kết quả in ra giống hệt
+    bool use_relabel = argc > 1 && string(argv[1]) == "--relabel";
     int n, root;
     vector<vector<int>> tree;
     read_tree(n, tree, root);
     cout << "Thu tu duyet preorder: ";
-    preorder(root, tree);
+    if (use_relabel) preorder_relabeled(relabel_tree(tree, root, RelabelOrder::PREORDER));
+    else preorder(root, tree);
     cout << '\n';
     return 0;
 }
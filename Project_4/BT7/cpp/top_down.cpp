@@ -1,6 +1,10 @@
 #include <iostream>
 #include <vector>
+#include <string>
 #include <queue>
+
+#include "../../../common/tree_relabel.h"
+
 using namespace std;
 
 // Đọc cây từ input dạng danh sách cha-con
@@ -46,10 +50,27 @@ void top_down(const vector<vector<int>> &tree, int root) {
     }
 }
 
-int main() {
+// Duyệt top-down trên cây đã đánh số lại theo BFS: mỗi mức là một đoạn liên tiếp các số hiệu
+void top_down_relabeled(const RelabeledTree &t) {
+    vector<int> depth = node_depths(t);
+    cout << "Duyet top-down (cac dinh theo thu tu khong giam cua do sau, trai sang phai):\n";
+    for (int u = 0; u < t.n; ++u) {
+        if (u == 0 || depth[u] != depth[u - 1]) {
+            if (u > 0) cout << '\n';
+            cout << "Do sau " << depth[u] << ": ";
+        }
+        cout << t.original[u] << ' ';
+    }
+    cout << '\n';
+}
+
+int main(int argc, char *argv[]) {
+    // --relabel: duyệt trên cây đã đánh số lại, kết quả in ra giống hệt
+    bool use_relabel = argc > 1 && string(argv[1]) == "--relabel";
     int n, root;
     vector<vector<int>> tree;
     read_tree(n, tree, root);
-    top_down(tree, root);
+    if (use_relabel) top_down_relabeled(relabel_tree(tree, root, RelabelOrder::BFS));
+    else top_down(tree, root);
     return 0;
 }
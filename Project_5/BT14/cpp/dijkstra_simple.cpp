@@ -2,6 +2,9 @@
 #include <vector>
 #include <queue>
 #include <limits>
+#include <string>
+
+#include "../../../common/graph_loader.h" // Graph files in every format (.inp, DIMACS, SGB, .bin, .nga)
 
 // Dijkstra's algorithm for a finite simple graph
 // Author: Nguyễn Ngọc Thạch
@@ -16,7 +19,8 @@ using pii = pair<int, int>; // (distance, vertex)
 // n: number of vertices (vertices are 0-indexed)
 // adj: adjacency list where adj[u] = vector of pairs (v, w) meaning edge u-v with weight w
 // src: source vertex
-vector<int> dijkstra(int n, const vector<vector<pii>>& adj, int src) {
+template <typename Graph> // vector<vector<pii>> or BinaryGraph::WeightedAdjacency
+vector<int> dijkstra(int n, const Graph& adj, int src) {
     vector<int> dist(n, numeric_limits<int>::max()); // Distance from src to each vertex
     priority_queue<pii, vector<pii>, greater<pii>> pq; // Min-heap priority queue
     dist[src] = 0;
@@ -41,7 +45,40 @@ vector<int> dijkstra(int n, const vector<vector<pii>>& adj, int src) {
     return dist;
 }
 
-int main() {
+// Runs Dijkstra on a weighted graph file in any format of common/graph_loader.h
+// (.inp, DIMACS, SGB, .bin or .nga). A .bin file is memory-mapped and used without parsing.
+// The source vertex is start_arg if given, else the one after the edges of an .inp file;
+// nothing is read from the keyboard, so the tool can run in scripts.
+int run_file(const char* path, const char* start_arg) {
+    BinaryGraph graph;
+    GraphFileInfo info;
+    string error;
+    int src;
+    if (!load_graph(path, graph, error, &info) ||
+        !choose_start_vertex(start_arg, info, graph.n(), "source vertex", src, error)) {
+        cerr << "Error: " << error << endl;
+        return 1;
+    }
+    if (!graph.has_weights()) {
+        cerr << "Error: " << path << " has no edge weights" << endl;
+        return 1;
+    }
+    int n = graph.n();
+    vector<int> dist = dijkstra(n, graph.weighted_adjacency(), src);
+    cout << "Shortest distances from vertex " << src << ":\n";
+    for (int i = 0; i < n; ++i) {
+        if (dist[i] == numeric_limits<int>::max())
+            cout << "Vertex " << i << ": INF\n";
+        else
+            cout << "Vertex " << i << ": " << dist[i] << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Graph file, and optionally the source vertex, given on the command line
+    if (argc > 1) return run_file(argv[1], argc > 2 ? argv[2] : nullptr);
+
     int n, m;
     cout << "Enter number of vertices and edges: ";
     cin >> n >> m;
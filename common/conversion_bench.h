@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <malloc.h> // Heap block sizes for the allocation counters
+
+// ========== CONVERSION BENCHMARK ==========
+// The --bench mode of the represent tools: a grid of random graphs, one (n, density) pair at
+// a time, on which every conversion of the tool is timed and its heap use counted. One CSV
+// line per conversion: wall time, peak heap growth during the conversion (result included),
+// number of allocations and edges per second.
+//
+// The heap is counted by replacing the global operator new and operator delete. Replacement
+// allocation functions cannot be inline, so this header must be included in exactly one
+// translation unit of a program; each represent tool is a single file. Counting is off until
+// run_bench_grid turns it on, so the other modes only pay one relaxed load per call.
+
+#ifdef _WIN32
+inline size_t heap_block_size(void* p) { return _msize(p); }
+#else
+inline size_t heap_block_size(void* p) { return malloc_usable_size(p); }
+#endif
+
+inline std::atomic<bool> heap_counting{false};
+inline std::atomic<long long> heap_live_bytes{0};
+inline std::atomic<long long> heap_peak_bytes{0};
+inline std::atomic<long long> heap_allocations{0};
+
+void* operator new(size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    if (heap_counting.load(std::memory_order_relaxed)) {
+        long long live = heap_live_bytes += heap_block_size(p);
+        heap_allocations++;
+        long long peak = heap_peak_bytes.load();
+        while (live > peak && !heap_peak_bytes.compare_exchange_weak(peak, live)) {}
+    }
+    return p;
+}
+
+// Both operator deletes end here. A block allocated before counting started and freed after
+// takes its size off the live count; only differences of it are reported, so that shifts
+// nothing. Kept out of line: GCC takes a free() inlined next to the operator new of the same
+// block for a mismatched new/delete pair.
+[[gnu::noinline]] inline void heap_release(void* p) noexcept {
+    if (!p) return;
+    if (heap_counting.load(std::memory_order_relaxed)) heap_live_bytes -= heap_block_size(p);
+    std::free(p);
+}
+
+void operator delete(void* p) noexcept {
+    heap_release(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    heap_release(p);
+}
+
+// One graph of the grid: the CSV columns in front of every conversion of it.
+struct BenchCase {
+    const char* graph_class; // "simple", "multi" or "general"
+    int n;
+    double density;
+    long long m;
+};
+
+// Times one conversion and prints its CSV line; the result is freed only after measuring.
+template <class Source, class Convert>
+void bench_conversion(const BenchCase& bench, const char* name, const Source& source, Convert convert) {
+    long long base = heap_live_bytes;
+    heap_peak_bytes = base;
+    long long allocations = heap_allocations;
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = convert(source);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    long long peak = heap_peak_bytes - base;
+    allocations = heap_allocations - allocations;
+    double edges_per_s = ms > 0 ? bench.m / (ms / 1000.0) : 0;
+    std::cout << bench.graph_class << "," << bench.n << "," << bench.density << "," << bench.m << "," << name << ","
+              << ms << "," << peak << "," << allocations << "," << (long long)edges_per_s << "\n";
+}
+
+// Parses a comma separated list of numbers, e.g. "100,1000".
+inline std::vector<double> parse_number_list(const std::string& text) {
+    std::vector<double> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) values.push_back(std::atof(item.c_str()));
+    }
+    return values;
+}
+
+// Runs "--bench [n1,n2,...] [d1,d2,...]" (argv[2] and argv[3]): for every pair of the grid,
+// generate(n, density, rng, m) builds a graph with m edges and run(bench, graph) calls
+// bench_conversion once per conversion.
+template <class Generate, class Run>
+int run_bench_grid(int argc, char* argv[], const char* graph_class, Generate generate, Run run) {
+    std::vector<double> sizes = argc > 2 ? parse_number_list(argv[2]) : std::vector<double>{100, 250, 500, 1000};
+    std::vector<double> densities = argc > 3 ? parse_number_list(argv[3]) : std::vector<double>{0.01, 0.05, 0.2};
+
+    heap_counting = true;
+    std::cout << "class,n,density,m,conversion,wall_ms,peak_bytes,allocations,edges_per_s\n";
+    std::mt19937 rng(2024); // Fixed seed, so every run measures the same graphs
+    for (double size : sizes) {
+        for (double density : densities) {
+            BenchCase bench{graph_class, (int)size, density, 0};
+            auto graph = generate(bench.n, density, rng, bench.m);
+            run(bench, graph);
+        }
+    }
+    return 0;
+}
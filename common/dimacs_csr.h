@@ -0,0 +1,180 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.h"
+#include "text_scan.h"
+
+// ========== DIMACS SCANNER ==========
+// Shared by the DIMACS readers of Project_4/BT5/E_1_1.cpp and by graph_loader.h. The readers
+// map the file and parse it in place: no line buffers, no streams. The line semantics are
+// the ones of the original getline/istringstream reader of E_1_1.cpp:
+//  - empty lines, comment lines ('c') and lines starting with any other character are skipped;
+//  - "p <format> <n> <m>" sets n and m, and the format word is not checked;
+//  - "e <u> <v>" appends the edge (u, v); the 'e' may be followed directly by u.
+// Anything after the last field of a 'p' or 'e' line is ignored, like the stream did.
+// A 'p' or 'e' line whose fields are missing or are not integers in the range of int is
+// malformed; the reader stops there and reports the byte offset where the line starts.
+
+// What one chunk of the file contains besides its edges.
+struct DimacsChunkInfo {
+    bool has_p = false;      // The chunk has a 'p' line; n and m are from its last one
+    int n = 0, m = 0;
+    bool malformed = false;  // Parsing stopped at the line at error_offset, for reason
+    size_t error_offset = 0;
+    const char* reason = "";
+};
+
+// Scans the lines of data[begin, end), where begin is a line start and end is a line start
+// or the file size, calling on_p(n, m) for every 'p' line and on_edge(u, v) for every 'e'
+// line. A callback returns false, after setting info.reason, to stop at its line.
+template <typename OnP, typename OnEdge>
+void scan_dimacs_chunk(const char* data, size_t begin, size_t end, DimacsChunkInfo& info, OnP on_p, OnEdge on_edge) {
+    const char* p = data + begin;
+    const char* stop = data + end;
+
+    while (p < stop) {
+        const char* line = p;
+        const char* eol = find_line_end(p, stop);
+
+        bool ok = true;
+        if (*line == 'e') {
+            int u, v;
+            p = line + 1;
+            if (!scan_int(p, eol, u) || !scan_int(p, eol, v)) {
+                info.reason = "malformed 'e' line";
+                ok = false;
+            } else {
+                ok = on_edge(u, v);
+            }
+        } else if (*line == 'p') {
+            int file_n, file_m;
+            p = line;
+            if (!skip_word(p, eol) || !skip_word(p, eol) ||
+                !scan_int(p, eol, file_n) || !scan_int(p, eol, file_m)) {
+                info.reason = "malformed 'p' line";
+                ok = false;
+            } else {
+                info.has_p = true;
+                info.n = file_n;
+                info.m = file_m;
+                ok = on_p(file_n, file_m);
+            }
+        }
+        if (!ok) {
+            info.malformed = true;
+            info.error_offset = line - data;
+            return;
+        }
+        p = eol + (eol < stop ? 1 : 0);
+    }
+}
+
+// ========== DIMACS TO CSR ==========
+// Parsed edges per batch of scattered updates in read_dimacs_csr.
+const size_t DIMACS_CSR_BATCH = 4096;
+
+// Undirected graph in CSR form, loaded straight from a DIMACS file: the neighbors of vertex v
+// are neighbor[offset[v] .. offset[v + 1]). Vertices are 0-based, so vertex v of the file is
+// row v - 1. Every edge (u, v) gives the arc u -> v and the arc v -> u, in file order within
+// each row, and a loop appears twice, as in the binary graph files of common/graph_binary.h.
+struct DimacsCSR {
+    int n = 0;
+    long long m = 0;            // Edge lines read
+    std::vector<long long> offset;   // n + 1 entries
+    std::vector<int> neighbor;       // 2 * m entries
+};
+
+// Loads a DIMACS file into graph in two passes over the mapping, without an edge list:
+// the first pass counts the degrees from the 'p' and 'e' lines, and the second fills the
+// neighbor array in place, so the peak memory is the size of the CSR itself. The degrees
+// are counted in offset shifted by two, so that after the prefix sum offset[u + 1] is the
+// fill position of row u, and ends up as the end of row u without a separate cursor array.
+// The scattered updates of both passes are applied in batches of parsed edges: interleaved
+// with the parsing, every cache miss on offset or neighbor stalls the scanner, while a tight
+// loop over a batch lets the misses overlap.
+// Besides malformed lines it is an error when an 'e' line comes before the 'p' line, names
+// a vertex outside 1..n, or when there is a second 'p' line.
+inline bool read_dimacs_csr(const std::string& file_path, DimacsCSR& graph, std::string& error) {
+    MappedFile file;
+    if (!file.open(file_path, error)) return false;
+    const char* data = file.data();
+    size_t size = file.size();
+
+    graph = DimacsCSR();
+    DimacsChunkInfo info;
+    bool have_p = false;
+    std::vector<long long>& offset = graph.offset;
+    std::vector<std::pair<int, int>> batch;
+    batch.reserve(DIMACS_CSR_BATCH);
+    auto count_batch = [&]() {
+        for (const auto& e : batch) {
+            offset[e.first + 1]++; // Row u - 1, shifted by two
+            offset[e.second + 1]++;
+        }
+        batch.clear();
+    };
+    scan_dimacs_chunk(data, 0, size, info,
+        [&](int n, int) {
+            if (have_p) {
+                info.reason = "second 'p' line";
+                return false;
+            }
+            if (n < 0) {
+                info.reason = "negative vertex count in 'p' line";
+                return false;
+            }
+            have_p = true;
+            graph.n = n;
+            offset.assign((size_t)n + 2, 0);
+            return true;
+        },
+        [&](int u, int v) {
+            if (!have_p) {
+                info.reason = "'e' line before the 'p' line";
+                return false;
+            }
+            if (u < 1 || u > graph.n || v < 1 || v > graph.n) {
+                info.reason = "vertex out of range in 'e' line";
+                return false;
+            }
+            batch.push_back({u, v});
+            if (batch.size() == DIMACS_CSR_BATCH) count_batch();
+            graph.m++;
+            return true;
+        });
+    count_batch();
+    if (!info.malformed && !have_p) {
+        info.malformed = true;
+        info.reason = "no 'p' line";
+        info.error_offset = size;
+    }
+    if (info.malformed) {
+        error = file_path + ": " + info.reason + " at byte offset " + std::to_string(info.error_offset);
+        graph = DimacsCSR();
+        return false;
+    }
+
+    for (int v = 0; v < graph.n; v++) offset[v + 2] += offset[v + 1];
+    graph.neighbor.resize(2 * graph.m);
+    auto fill_batch = [&]() {
+        for (const auto& e : batch) {
+            graph.neighbor[offset[e.first]++] = e.second - 1; // offset[(u - 1) + 1] is the cursor of row u - 1
+            graph.neighbor[offset[e.second]++] = e.first - 1;
+        }
+        batch.clear();
+    };
+    DimacsChunkInfo fill_info;
+    scan_dimacs_chunk(data, 0, size, fill_info,
+        [](int, int) { return true; },
+        [&](int u, int v) {
+            batch.push_back({u, v});
+            if (batch.size() == DIMACS_CSR_BATCH) fill_batch();
+            return true;
+        });
+    fill_batch();
+    offset.pop_back();
+    return true;
+}
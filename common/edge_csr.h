@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Incidence index of an undirected edge array in CSR form: the ids of the edges incident to
+// v are incident[offset[v] .. offset[v + 1]), in increasing id order, and a loop is listed
+// once. The edge array itself is not touched, so edge i stays the i-th input edge.
+//
+// The index is built by writing one (vertex, edge id) arc per endpoint in id order and
+// sorting the arcs by vertex with an LSD radix sort, 11 bits of the vertex per pass. Every
+// pass is split over the threads by contiguous blocks of arcs: each thread counts the digits
+// of its block, a prefix sum over (digit, thread) gives every thread its own output ranges,
+// and the threads scatter their blocks in order, so the sort is stable and the ids stay
+// increasing within each vertex whatever the thread count. Each pass scatters into only 2048
+// output streams, unlike a counting sort over n buckets, which scatters across the whole
+// output once n outgrows the cache, and its counting pass splits over the threads as well.
+
+namespace edge_csr_detail {
+
+// Runs body(t, begin, end) for the t-th of 'threads' contiguous blocks of [0, count);
+// block 0 runs on the calling thread.
+template <typename Body>
+void for_blocks(size_t count, int threads, Body body) {
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) {
+        workers.emplace_back(body, t, count * t / threads, count * (t + 1) / threads);
+    }
+    body(0, (size_t)0, count / threads);
+    for (auto& w : workers) w.join();
+}
+
+} // namespace edge_csr_detail
+
+// Arcs per thread below which more threads are not worth starting.
+const size_t EDGE_CSR_MIN_ARCS_PER_THREAD = 1 << 16;
+// Bits of the vertex sorted per pass: two passes up to 4M vertices, with 16 KB count tables.
+const int EDGE_CSR_DIGIT_BITS = 11;
+const size_t EDGE_CSR_RADIX = (size_t)1 << EDGE_CSR_DIGIT_BITS;
+
+inline void build_incidence_csr(int n, const std::vector<std::pair<int, int>>& edges, int threads,
+                                std::vector<int>& offset, std::vector<int>& incident) {
+    using edge_csr_detail::for_blocks;
+    size_t m = edges.size();
+    if (threads < 1) threads = 1;
+
+    // Arcs in id order; per-block loop counts place every block's arcs without a serial pass
+    int edge_threads = (int)std::max<size_t>(1, std::min<size_t>(threads, m / EDGE_CSR_MIN_ARCS_PER_THREAD));
+    std::vector<size_t> block_arcs(edge_threads + 1, 0);
+    for_blocks(m, edge_threads, [&](int t, size_t begin, size_t end) {
+        size_t arcs = 0;
+        for (size_t i = begin; i < end; ++i) arcs += edges[i].first == edges[i].second ? 1 : 2;
+        block_arcs[t + 1] = arcs;
+    });
+    for (int t = 0; t < edge_threads; ++t) block_arcs[t + 1] += block_arcs[t];
+    size_t arc_count = block_arcs[edge_threads];
+
+    // An arc is (vertex << 32) | edge id, so a pass moves one word per arc
+    std::vector<uint64_t> arc(arc_count), arc_tmp(arc_count);
+    for_blocks(m, edge_threads, [&](int t, size_t begin, size_t end) {
+        size_t a = block_arcs[t];
+        for (size_t i = begin; i < end; ++i) {
+            arc[a++] = ((uint64_t)(uint32_t)edges[i].first << 32) | (uint32_t)i;
+            if (edges[i].first != edges[i].second) arc[a++] = ((uint64_t)(uint32_t)edges[i].second << 32) | (uint32_t)i;
+        }
+    });
+
+    int sort_threads = (int)std::max<size_t>(1, std::min<size_t>(threads, arc_count / EDGE_CSR_MIN_ARCS_PER_THREAD));
+    std::vector<std::vector<size_t>> position(sort_threads, std::vector<size_t>(EDGE_CSR_RADIX));
+    uint32_t max_vertex = n > 0 ? (uint32_t)(n - 1) : 0;
+    for (int shift = 32; shift < 64 && (max_vertex >> (shift - 32)) != 0; shift += EDGE_CSR_DIGIT_BITS) {
+        for_blocks(arc_count, sort_threads, [&](int t, size_t begin, size_t end) {
+            std::vector<size_t>& count = position[t];
+            std::fill(count.begin(), count.end(), 0);
+            for (size_t a = begin; a < end; ++a) count[(arc[a] >> shift) & (EDGE_CSR_RADIX - 1)]++;
+        });
+        size_t total = 0;
+        for (size_t digit = 0; digit < EDGE_CSR_RADIX; ++digit) {
+            for (int t = 0; t < sort_threads; ++t) {
+                size_t count = position[t][digit];
+                position[t][digit] = total; // Where thread t starts writing this digit
+                total += count;
+            }
+        }
+        for_blocks(arc_count, sort_threads, [&](int t, size_t begin, size_t end) {
+            std::vector<size_t>& next = position[t];
+            for (size_t a = begin; a < end; ++a) {
+                arc_tmp[next[(arc[a] >> shift) & (EDGE_CSR_RADIX - 1)]++] = arc[a];
+            }
+        });
+        arc.swap(arc_tmp);
+    }
+    arc_tmp = std::vector<uint64_t>();
+
+    // offset[v] is the first arc with vertex >= v; every entry is written by exactly one block
+    offset.assign(n + 1, 0);
+    incident.resize(arc_count);
+    for_blocks(arc_count, sort_threads, [&](int, size_t begin, size_t end) {
+        for (size_t a = begin; a < end; ++a) {
+            long long previous = a == 0 ? -1 : (long long)(arc[a - 1] >> 32);
+            for (long long v = previous + 1; v <= (long long)(arc[a] >> 32); ++v) offset[v] = (int)a;
+            incident[a] = (int)(uint32_t)arc[a];
+        }
+    });
+    long long last = arc_count == 0 ? -1 : (long long)(arc[arc_count - 1] >> 32);
+    for (long long v = last + 1; v <= n; ++v) offset[v] = (int)arc_count;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+
+// Heap bytes owned by a container, counted from its capacity rather than its size, so the
+// slack left by push_back growth is included, and recursing into nested containers.
+// Hash maps count the bucket array plus one node per element with the node layout of
+// libstdc++ (next pointer + element; hash codes of integer keys are not cached), which is
+// what both the Linux and the MinGW builds of the tools use.
+// The numbers are the bytes requested from the allocator; malloc's own rounding and block
+// headers are not included.
+
+// Declared up front so that nested containers find every overload.
+template <typename T> size_t heapBytes(const T&);
+template <typename A, typename B> size_t heapBytes(const std::pair<A, B>& p);
+template <typename T> size_t heapBytes(const std::vector<T>& v);
+inline size_t heapBytes(const std::vector<bool>& v);
+template <typename K, typename V> size_t heapBytes(const std::unordered_map<K, V>& m);
+
+// Scalars own no heap memory.
+template <typename T>
+size_t heapBytes(const T&) { return 0; }
+
+template <typename A, typename B>
+size_t heapBytes(const std::pair<A, B>& p) { return heapBytes(p.first) + heapBytes(p.second); }
+
+template <typename T>
+size_t heapBytes(const std::vector<T>& v) {
+    size_t bytes = v.capacity() * sizeof(T);
+    for (const T& x : v) bytes += heapBytes(x);
+    return bytes;
+}
+
+// vector<bool> is packed into 64-bit words.
+inline size_t heapBytes(const std::vector<bool>& v) { return (v.capacity() + 63) / 64 * 8; }
+
+template <typename K, typename V>
+size_t heapBytes(const std::unordered_map<K, V>& m) {
+    struct Node {
+        void* next;
+        std::pair<const K, V> value;
+    };
+    size_t bytes = m.size() * sizeof(Node);
+    if (m.bucket_count() > 1) bytes += m.bucket_count() * sizeof(void*); // A single bucket lives inside the map object
+    for (const auto& kv : m) bytes += heapBytes(kv.second);
+    return bytes;
+}
@@ -0,0 +1,438 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.h"
+
+// ========== COMPRESSED GRAPH ARCHIVE (.nga), VERSION 2 ==========
+// Sorted adjacency lists compressed with gaps and variable-length integers, for storing
+// graphs several times smaller than DIMACS or SGB text and loading them faster:
+//
+//   GraphArchiveHeader                        (64 bytes)
+//   uint64_t block_offset[blocks + 1]         start of every block in the adjacency data
+//   uint8_t  adjacency[adjacency_bytes]
+//   uint64_t label_offset[blocks + 1]         if flags & ARCHIVE_VERTEX_LABELS
+//   uint8_t  labels[label_bytes]              if flags & ARCHIVE_VERTEX_LABELS
+//
+// Vertices are grouped in blocks of ARCHIVE_BLOCK_VERTICES, so a vertex is found by jumping
+// to its block and skipping at most ARCHIVE_BLOCK_VERTICES - 1 lists. Every vertex v is
+//   varint degree, then for every neighbor in increasing order:
+//   varint gap (the first neighbor minus the start, then the difference to the previous one),
+//   zigzag varint arc label (if flags & ARCHIVE_ARC_LABELS)
+// and its label is a varint length followed by the bytes. A varint stores 7 bits per byte,
+// low bits first, with the high bit set on every byte but the last; zigzag maps a signed
+// label to an unsigned one so that small negative labels stay short.
+// With ARCHIVE_SYMMETRIC the graph is undirected and every edge {u, v}, u <= v, is stored
+// once, as the arc u -> v (a loop once too); the start of the gaps of v is v itself, so no
+// row can hold a lower neighbor, and a reader wanting both directions mirrors the arcs.
+// Otherwise every arc is stored once, at its source, and the start is 0. Version 1 stored
+// both arcs of a symmetric edge, which doubled the file. All integers in the header and
+// tables are little-endian.
+
+const char ARCHIVE_MAGIC[8] = {'N', 'N', 'T', 'G', 'A', 'R', 'C', 'H'};
+const uint32_t ARCHIVE_FORMAT_VERSION = 2;
+const uint32_t ARCHIVE_SYMMETRIC = 1;
+const uint32_t ARCHIVE_ARC_LABELS = 2;
+const uint32_t ARCHIVE_VERTEX_LABELS = 4;
+const uint32_t ARCHIVE_BLOCK_VERTICES = 64;
+
+struct GraphArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t n;               // Number of vertices
+    uint64_t m;               // Number of edges (symmetric) or arcs
+    uint64_t arcs;            // Number of stored arcs
+    uint64_t adjacency_bytes;
+    uint64_t label_bytes;
+    uint32_t block_vertices;
+    uint32_t reserved;
+};
+
+namespace archive_detail {
+
+inline void put_varint(std::vector<uint8_t>& out, uint64_t x) {
+    while (x >= 0x80) {
+        out.push_back((uint8_t)(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back((uint8_t)x);
+}
+
+inline uint64_t zigzag(int64_t x) { return ((uint64_t)x << 1) ^ (uint64_t)(x >> 63); }
+inline int64_t unzigzag(uint64_t x) { return (int64_t)(x >> 1) ^ -(int64_t)(x & 1); }
+
+// The multi-byte case of get_varint.
+inline bool get_long_varint(const uint8_t*& p, const uint8_t* end, uint64_t& x) {
+    x = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint64_t byte = *p++;
+        x |= (byte & 0x7f) << shift;
+        if (byte < 0x80) return true;
+    }
+    return false;
+}
+
+// Reads a varint at p, which must stay below end, into x and advances p; the one-byte case,
+// most gaps, is inlined. False if the varint runs past end or past 64 bits.
+inline bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& x) {
+    if (p < end && *p < 0x80) {
+        x = *p++;
+        return true;
+    }
+    return get_long_varint(p, end, x);
+}
+
+// Longest varint of a 64-bit value.
+const int ARCHIVE_MAX_VARINT_BYTES = 10;
+
+// Reads a varint at p without an end check, for a caller that knows ARCHIVE_MAX_VARINT_BYTES
+// bytes are there; false if the varint is longer than that.
+inline bool get_varint_unchecked(const uint8_t*& p, uint64_t& x) {
+    x = *p++;
+    if (x < 0x80) return true;
+    x &= 0x7f;
+    for (int shift = 7; shift < 64; shift += 7) {
+        uint64_t byte = *p++;
+        x |= (byte & 0x7f) << shift;
+        if (byte < 0x80) return true;
+    }
+    return false;
+}
+
+// Reads a varint length and that many bytes at p, below end, into label.
+inline bool get_label(const uint8_t*& p, const uint8_t* end, std::string_view& label) {
+    uint64_t length;
+    if (!get_varint(p, end, length) || length > (uint64_t)(end - p)) return false;
+    label = std::string_view((const char*)p, length);
+    p += length;
+    return true;
+}
+
+// Entry i of a block table. The label table follows the adjacency bytes, so it is not
+// always 8-byte aligned; entries are copied out instead of read through a uint64_t pointer.
+inline uint64_t table_entry(const uint8_t* table, uint64_t i) {
+    uint64_t x;
+    std::memcpy(&x, table + 8 * i, sizeof(x));
+    return x;
+}
+
+// A block table is valid if it starts at 0, never decreases and ends at the data size.
+inline bool block_table_valid(const uint8_t* table, uint64_t blocks, uint64_t bytes) {
+    if (table_entry(table, 0) != 0 || table_entry(table, blocks) != bytes) return false;
+    for (uint64_t b = 0; b < blocks; ++b) {
+        if (table_entry(table, b) > table_entry(table, b + 1)) return false;
+    }
+    return true;
+}
+
+} // namespace archive_detail
+
+// Writes a graph given in CSR form: the arcs of v are neighbor[offset[v] .. offset[v + 1]),
+// with arc_labels parallel to neighbor (empty for none) and one label per vertex in
+// vertex_labels (empty for none). The rows do not have to be sorted; every row is sorted
+// by (neighbor, label) on the way. m is the number of edges recorded in the header. A
+// symmetric graph is given by the lower end of every edge: no neighbor of v below v.
+inline bool write_graph_archive(const std::string& path, int n, uint64_t m, bool symmetric,
+                                const std::vector<long long>& offset, const std::vector<int>& neighbor,
+                                const std::vector<int>& arc_labels,
+                                const std::vector<std::string_view>& vertex_labels, std::string& error) {
+    using namespace archive_detail;
+    bool labelled = !arc_labels.empty();
+    uint64_t blocks = ((uint64_t)n + ARCHIVE_BLOCK_VERTICES - 1) / ARCHIVE_BLOCK_VERTICES;
+    std::vector<uint64_t> block_offset(blocks + 1, 0), label_offset;
+    std::vector<uint8_t> adjacency, labels;
+    adjacency.reserve(neighbor.size() * (labelled ? 3 : 2) + n);
+
+    std::vector<std::pair<int, int>> row;
+    for (int v = 0; v < n; ++v) {
+        if (v % ARCHIVE_BLOCK_VERTICES == 0) block_offset[v / ARCHIVE_BLOCK_VERTICES] = adjacency.size();
+        row.clear();
+        for (long long k = offset[v]; k < offset[v + 1]; ++k) row.push_back({neighbor[k], labelled ? arc_labels[k] : 0});
+        std::sort(row.begin(), row.end());
+        put_varint(adjacency, row.size());
+        int previous = symmetric ? v : 0;
+        for (const auto& arc : row) {
+            if (arc.first < 0 || arc.first >= n) {
+                error = path + ": arc " + std::to_string(v) + " -> " + std::to_string(arc.first) + " leaves the graph";
+                return false;
+            }
+            if (arc.first < previous) { // Only the first arc of a sorted row can be below v
+                error = path + ": edge " + std::to_string(v) + " - " + std::to_string(arc.first) +
+                        " is not given at its lower end";
+                return false;
+            }
+            put_varint(adjacency, (uint64_t)(arc.first - previous));
+            previous = arc.first;
+            if (labelled) put_varint(adjacency, zigzag(arc.second));
+        }
+    }
+    block_offset[blocks] = adjacency.size();
+
+    if (!vertex_labels.empty()) {
+        label_offset.assign(blocks + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            if (v % ARCHIVE_BLOCK_VERTICES == 0) label_offset[v / ARCHIVE_BLOCK_VERTICES] = labels.size();
+            put_varint(labels, vertex_labels[v].size());
+            labels.insert(labels.end(), vertex_labels[v].begin(), vertex_labels[v].end());
+        }
+        label_offset[blocks] = labels.size();
+    }
+
+    GraphArchiveHeader header{};
+    std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version = ARCHIVE_FORMAT_VERSION;
+    header.flags = (symmetric ? ARCHIVE_SYMMETRIC : 0) | (labelled ? ARCHIVE_ARC_LABELS : 0) |
+                   (vertex_labels.empty() ? 0 : ARCHIVE_VERTEX_LABELS);
+    header.n = n;
+    header.m = m;
+    header.arcs = neighbor.size();
+    header.adjacency_bytes = adjacency.size();
+    header.label_bytes = labels.size();
+    header.block_vertices = ARCHIVE_BLOCK_VERTICES;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)block_offset.data(), block_offset.size() * sizeof(uint64_t));
+    out.write((const char*)adjacency.data(), adjacency.size());
+    out.write((const char*)label_offset.data(), label_offset.size() * sizeof(uint64_t));
+    out.write((const char*)labels.data(), labels.size());
+    if (!out) {
+        error = "Cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+// A memory-mapped archive. Opening it checks the header and the block tables; lists are
+// decoded on access, sequentially with for_each_arc or per vertex with for_each_neighbor.
+// The file is not trusted: every list is decoded within the bytes of its block and every
+// neighbor checked against n, so a corrupt archive gives an error, never a read outside the
+// mapping or a vertex id outside [0, n).
+class GraphArchive {
+public:
+    bool open(const std::string& path, std::string& error) {
+        path_ = path;
+        if (!file_.open(path, error)) return false;
+        if (file_.size() < sizeof(GraphArchiveHeader) ||
+            std::memcmp(file_.data(), ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0) {
+            error = path + " is not a graph archive";
+            return false;
+        }
+        std::memcpy(&header_, file_.data(), sizeof(header_));
+        if (header_.version != ARCHIVE_FORMAT_VERSION || header_.block_vertices != ARCHIVE_BLOCK_VERTICES) {
+            error = path + ": unsupported graph archive version " + std::to_string(header_.version);
+            return false;
+        }
+
+        // Every size is bounded against the bytes left, so corrupt sizes cannot wrap around.
+        bool labelled = (header_.flags & ARCHIVE_VERTEX_LABELS) != 0;
+        uint64_t blocks = (header_.n + ARCHIVE_BLOCK_VERTICES - 1) / ARCHIVE_BLOCK_VERTICES;
+        uint64_t table = 8 * (blocks + 1);
+        uint64_t available = file_.size() - sizeof(GraphArchiveHeader);
+        bool fits = header_.n <= INT32_MAX && table <= available && header_.adjacency_bytes <= available - table;
+        if (fits && labelled) {
+            available -= table + header_.adjacency_bytes;
+            fits = table <= available && header_.label_bytes <= available - table;
+        }
+        if (!fits) {
+            error = path + ": truncated graph archive";
+            return false;
+        }
+        // Every arc takes a byte at least, and a symmetric edge is one arc
+        if (header_.arcs > header_.adjacency_bytes || header_.m > header_.arcs ||
+            ((header_.flags & ARCHIVE_SYMMETRIC) != 0 && header_.m != header_.arcs)) {
+            error = path + ": corrupt arc count in graph archive";
+            return false;
+        }
+
+        const char* p = file_.data() + sizeof(GraphArchiveHeader);
+        block_offset_ = (const uint8_t*)p;
+        p += table;
+        adjacency_ = (const uint8_t*)p;
+        p += header_.adjacency_bytes;
+        label_offset_ = nullptr;
+        labels_ = nullptr;
+        if (labelled) {
+            label_offset_ = (const uint8_t*)p;
+            p += table;
+            labels_ = (const uint8_t*)p;
+        }
+        if (!archive_detail::block_table_valid(block_offset_, blocks, header_.adjacency_bytes) ||
+            (labelled && !archive_detail::block_table_valid(label_offset_, blocks, header_.label_bytes))) {
+            error = path + ": corrupt block offsets in graph archive";
+            return false;
+        }
+        return true;
+    }
+
+    int n() const { return (int)header_.n; }
+    long long m() const { return (long long)header_.m; }
+    long long arcs() const { return (long long)header_.arcs; }
+    bool symmetric() const { return (header_.flags & ARCHIVE_SYMMETRIC) != 0; }
+    bool has_arc_labels() const { return (header_.flags & ARCHIVE_ARC_LABELS) != 0; }
+    bool has_vertex_labels() const { return labels_ != nullptr; }
+
+    // Calls visit(v, u, label) for every arc in (v, u) order; label is 0 without arc labels.
+    // A symmetric archive gives every edge once, with v <= u.
+    // On a corrupt list error names the vertex, and the arcs before it have been visited.
+    template <typename Visit>
+    bool for_each_arc(Visit visit, std::string& error) const {
+        bool labelled = has_arc_labels();
+        uint64_t arcs = 0;
+        int v = 0;
+        for (uint64_t b = 0; v < n(); ++b) {
+            const uint8_t* p = adjacency_ + archive_detail::table_entry(block_offset_, b);
+            const uint8_t* end = adjacency_ + archive_detail::table_entry(block_offset_, b + 1);
+            int last = (int)std::min<uint64_t>(header_.n, (b + 1) * ARCHIVE_BLOCK_VERTICES);
+            for (; v < last; ++v) {
+                p = decode_list(p, end, v, labelled, visit, arcs);
+                if (p == nullptr) return corrupt_list(v, error);
+            }
+            if (p != end) return corrupt_list(last - 1, error);
+        }
+        if (arcs != header_.arcs) {
+            error = path_ + ": graph archive holds " + std::to_string(arcs) + " arcs, its header " + std::to_string(header_.arcs);
+            return false;
+        }
+        return true;
+    }
+
+    // Calls visit(v, u, label) for the arcs of v, in increasing u; in a symmetric archive
+    // only the neighbors u >= v.
+    template <typename Visit>
+    bool for_each_neighbor(int v, Visit visit, std::string& error) const {
+        const uint8_t* end;
+        const uint8_t* p = seek_list(v, end);
+        uint64_t arcs = 0;
+        if (p == nullptr || decode_list(p, end, v, has_arc_labels(), visit, arcs) == nullptr) return corrupt_list(v, error);
+        return true;
+    }
+
+    // Degree of v, or -1 if the lists up to v are corrupt.
+    int degree(int v) const {
+        const uint8_t* end;
+        const uint8_t* p = seek_list(v, end);
+        uint64_t degree;
+        if (p == nullptr || !archive_detail::get_varint(p, end, degree) || degree > (uint64_t)(end - p)) return -1;
+        return (int)degree;
+    }
+
+    // Calls visit(v, label) for every vertex in order (requires has_vertex_labels).
+    template <typename Visit>
+    bool for_each_vertex_label(Visit visit, std::string& error) const {
+        const uint8_t* p = labels_;
+        const uint8_t* end = labels_ + header_.label_bytes;
+        for (int v = 0; v < n(); ++v) {
+            std::string_view label;
+            if (!archive_detail::get_label(p, end, label)) return corrupt_label(v, error);
+            visit(v, label);
+        }
+        return true;
+    }
+
+    // Label of one vertex (requires has_vertex_labels).
+    bool vertex_label(int v, std::string_view& label, std::string& error) const {
+        const uint8_t* p = labels_ + archive_detail::table_entry(label_offset_, v / ARCHIVE_BLOCK_VERTICES);
+        const uint8_t* end = labels_ + archive_detail::table_entry(label_offset_, v / ARCHIVE_BLOCK_VERTICES + 1);
+        for (int skip = v % ARCHIVE_BLOCK_VERTICES; skip >= 0; --skip) {
+            if (!archive_detail::get_label(p, end, label)) return corrupt_label(v, error);
+        }
+        return true;
+    }
+
+private:
+    MappedFile file_;
+    std::string path_;
+    GraphArchiveHeader header_{};
+    const uint8_t* block_offset_ = nullptr; // Block tables, read with table_entry
+    const uint8_t* adjacency_ = nullptr;
+    const uint8_t* label_offset_ = nullptr;
+    const uint8_t* labels_ = nullptr;
+
+    bool corrupt_list(int v, std::string& error) const {
+        error = path_ + ": corrupt adjacency list of vertex " + std::to_string(v) + " in graph archive";
+        return false;
+    }
+    bool corrupt_label(int v, std::string& error) const {
+        error = path_ + ": corrupt label of vertex " + std::to_string(v) + " in graph archive";
+        return false;
+    }
+
+    // Start of the list of v: its block, then the lists before it in the block; end receives
+    // the end of the block. nullptr if a skipped list runs past it.
+    const uint8_t* seek_list(int v, const uint8_t*& end) const {
+        const uint8_t* p = adjacency_ + archive_detail::table_entry(block_offset_, v / ARCHIVE_BLOCK_VERTICES);
+        end = adjacency_ + archive_detail::table_entry(block_offset_, v / ARCHIVE_BLOCK_VERTICES + 1);
+        uint64_t values_per_arc = has_arc_labels() ? 2 : 1;
+        for (int skip = v % ARCHIVE_BLOCK_VERTICES; skip > 0; --skip) {
+            uint64_t degree;
+            if (!archive_detail::get_varint(p, end, degree) || degree > (uint64_t)(end - p)) return nullptr;
+            for (uint64_t k = 0; k < degree * values_per_arc; ++k) {
+                do {
+                    if (p == end) return nullptr;
+                } while (*p++ >= 0x80);
+            }
+        }
+        return p;
+    }
+
+    // Decodes the list of v at p, calling visit(v, u, label) for every arc and adding the
+    // degree to arcs. Returns the end of the list, or nullptr if it runs past end or a
+    // neighbor falls outside [start, n).
+    template <typename Visit>
+    const uint8_t* decode_list(const uint8_t* p, const uint8_t* end, int v, bool labelled, Visit& visit, uint64_t& arcs) const {
+        uint64_t degree;
+        // Every arc takes a byte at least, which also bounds the loop on a corrupt degree
+        if (!archive_detail::get_varint(p, end, degree) || degree > (uint64_t)(end - p)) return nullptr;
+        arcs += degree;
+        // Most lists are far enough from the end of their block that even the longest
+        // varints would fit; those are read without a bounds check per byte.
+        uint64_t values = labelled ? 2 * degree : degree;
+        bool room = values <= (uint64_t)(end - p) / archive_detail::ARCHIVE_MAX_VARINT_BYTES;
+        uint64_t start = symmetric() ? (uint64_t)v : 0;
+        if (labelled) {
+            return room ? decode_arcs<true, false>(p, end, v, start, degree, visit)
+                        : decode_arcs<true, true>(p, end, v, start, degree, visit);
+        }
+        return room ? decode_arcs<false, false>(p, end, v, start, degree, visit)
+                    : decode_arcs<false, true>(p, end, v, start, degree, visit);
+    }
+
+    template <bool checked>
+    static bool read_varint(const uint8_t*& p, const uint8_t* end, uint64_t& x) {
+        return checked ? archive_detail::get_varint(p, end, x) : archive_detail::get_varint_unchecked(p, x);
+    }
+
+    template <bool labelled, bool checked, typename Visit>
+    const uint8_t* decode_arcs(const uint8_t* p, const uint8_t* end, int v, uint64_t start, uint64_t degree,
+                               Visit& visit) const {
+        const uint64_t n = header_.n;
+        uint64_t u = start, gap, label = 0;
+        for (uint64_t k = 0; k < degree; ++k) {
+            if (!read_varint<checked>(p, end, gap) || gap >= n - u) return nullptr;
+            if (labelled && !read_varint<checked>(p, end, label)) return nullptr;
+            u += gap;
+            visit(v, (int)u, (int)archive_detail::unzigzag(label));
+        }
+        return p;
+    }
+};
+
+// Returns true if the file starts with the archive magic.
+inline bool is_graph_archive_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(ARCHIVE_MAGIC)];
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, ARCHIVE_MAGIC, sizeof(magic)) == 0;
+}
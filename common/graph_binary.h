@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+
+#include "mapped_file.h"
+
+// ========== BINARY GRAPH FORMAT (.bin), VERSION 1 ==========
+// A graph stored as the adjacency lists the tools build from an .inp file, in CSR form,
+// so it can be used straight from a memory mapping without parsing:
+//
+//   BinaryGraphHeader                      (40 bytes)
+//   uint64_t offsets[n + 1]                neighbors of v are [offsets[v], offsets[v + 1])
+//   int32_t  neighbors[arcs]
+//   int32_t  weights[arcs]                 if flags & GRAPH_HAS_WEIGHTS
+//   int32_t  edge_ids[arcs]                if flags & GRAPH_HAS_EDGE_IDS (input line of the edge)
+//
+// All integers are little-endian. Every input edge (u, v) contributes the arc u -> v and
+// the arc v -> u, exactly in the order the .inp readers push them, so the adjacency list of
+// every vertex is the same as the one read from the text file (a loop appears twice).
+
+const char GRAPH_MAGIC[8] = {'N', 'N', 'T', 'G', 'R', 'A', 'P', 'H'};
+const uint32_t GRAPH_FORMAT_VERSION = 1;
+const uint32_t GRAPH_HAS_WEIGHTS = 1;
+const uint32_t GRAPH_HAS_EDGE_IDS = 2;
+
+struct BinaryGraphHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t n;    // Number of vertices
+    uint64_t m;    // Number of input edges
+    uint64_t arcs; // Length of the neighbor array, offsets[n]
+};
+
+// Neighbors of one vertex; behaves like the vector<int> of an adjacency list.
+struct NeighborRange {
+    const int32_t* first;
+    const int32_t* last;
+
+    const int32_t* begin() const { return first; }
+    const int32_t* end() const { return last; }
+    int size() const { return (int)(last - first); }
+    int operator[](int i) const { return first[i]; }
+};
+
+// Neighbors of one vertex with weights; iterates (v, w) pairs like a vector<pair<int, int>>.
+struct WeightedNeighborRange {
+    struct iterator {
+        const int32_t* v;
+        const int32_t* w;
+        std::pair<int, int> operator*() const { return {*v, *w}; }
+        iterator& operator++() { ++v; ++w; return *this; }
+        bool operator!=(const iterator& other) const { return v != other.v; }
+    };
+
+    const int32_t* neighbors;
+    const int32_t* weights;
+    int count;
+
+    iterator begin() const { return {neighbors, weights}; }
+    iterator end() const { return {neighbors + count, weights + count}; }
+    int size() const { return count; }
+    std::pair<int, int> operator[](int i) const { return {neighbors[i], weights[i]}; }
+};
+
+// A graph in the CSR layout of the binary format. open() memory-maps a .bin file and checks
+// the offsets and neighbor ids once, in O(n + arcs) sequential reads and no allocation, so a
+// corrupt file is rejected there instead of sending a traversal out of bounds; assign()
+// takes over arrays built in memory, which is how graph_loader.h hands out graphs read from
+// the text formats, so the tools see one graph type whatever the file was.
+class BinaryGraph {
+public:
+    // Drop-in replacements for const vector<vector<int>>& and const vector<vector<pii>>&.
+    struct Adjacency {
+        const BinaryGraph* g;
+        int size() const { return g->n(); }
+        NeighborRange operator[](int v) const { return g->neighbors(v); }
+    };
+    struct WeightedAdjacency {
+        const BinaryGraph* g;
+        int size() const { return g->n(); }
+        WeightedNeighborRange operator[](int v) const { return g->weighted_neighbors(v); }
+    };
+
+    bool open(const std::string& path, std::string& error) {
+        release();
+        if (!file_.open(path, error)) return false;
+        if (file_.size() < sizeof(BinaryGraphHeader) ||
+            std::memcmp(file_.data(), GRAPH_MAGIC, sizeof(GRAPH_MAGIC)) != 0) {
+            return fail(path + " is not a binary graph file", error);
+        }
+        std::memcpy(&header_, file_.data(), sizeof(header_));
+        if (header_.version != GRAPH_FORMAT_VERSION) {
+            return fail(path + ": unsupported binary graph version " + std::to_string(header_.version), error);
+        }
+
+        // Sizes from the header are bounded one at a time against the file, so a corrupt
+        // count cannot wrap the expected size around.
+        uint64_t arrays = 1 + ((header_.flags & GRAPH_HAS_WEIGHTS) ? 1 : 0) + ((header_.flags & GRAPH_HAS_EDGE_IDS) ? 1 : 0);
+        uint64_t available = file_.size() - sizeof(BinaryGraphHeader);
+        if (header_.n > INT32_MAX || 8 * (header_.n + 1) > available ||
+            header_.arcs > (available - 8 * (header_.n + 1)) / (4 * arrays)) {
+            return fail(path + ": truncated binary graph file", error);
+        }
+
+        const char* p = file_.data() + sizeof(BinaryGraphHeader);
+        offsets_ = (const uint64_t*)p;
+        p += 8 * (header_.n + 1);
+        neighbors_ = (const int32_t*)p;
+        p += 4 * header_.arcs;
+        weights_ = nullptr;
+        edge_ids_ = nullptr;
+        if (header_.flags & GRAPH_HAS_WEIGHTS) {
+            weights_ = (const int32_t*)p;
+            p += 4 * header_.arcs;
+        }
+        if (header_.flags & GRAPH_HAS_EDGE_IDS) edge_ids_ = (const int32_t*)p;
+        return validate(path, error);
+    }
+
+    // Takes over CSR arrays built in memory: the arcs of v are neighbors[offsets[v] ..
+    // offsets[v + 1]), with weights parallel to neighbors (empty for none). m is the number
+    // of input edges.
+    void assign(int n, long long m, std::vector<uint64_t> offsets, std::vector<int32_t> neighbors,
+                std::vector<int32_t> weights) {
+        release();
+        header_.n = n;
+        header_.m = m;
+        header_.arcs = neighbors.size();
+        header_.flags = weights.empty() ? 0 : GRAPH_HAS_WEIGHTS;
+        owned_offsets_ = std::move(offsets);
+        owned_neighbors_ = std::move(neighbors);
+        owned_weights_ = std::move(weights);
+        offsets_ = owned_offsets_.data();
+        neighbors_ = owned_neighbors_.data();
+        weights_ = owned_weights_.empty() ? nullptr : owned_weights_.data();
+    }
+
+    int n() const { return (int)header_.n; }
+    long long m() const { return (long long)header_.m; }
+    bool has_weights() const { return weights_ != nullptr; }
+    bool has_edge_ids() const { return edge_ids_ != nullptr; }
+
+    NeighborRange neighbors(int v) const {
+        return {neighbors_ + offsets_[v], neighbors_ + offsets_[v + 1]};
+    }
+    WeightedNeighborRange weighted_neighbors(int v) const {
+        return {neighbors_ + offsets_[v], weights_ + offsets_[v], (int)(offsets_[v + 1] - offsets_[v])};
+    }
+    // Input edge that the k-th arc of v comes from (requires GRAPH_HAS_EDGE_IDS).
+    int edge_id(int v, int k) const { return edge_ids_[offsets_[v] + k]; }
+
+    Adjacency adjacency() const { return {this}; }
+    WeightedAdjacency weighted_adjacency() const { return {this}; }
+
+private:
+    MappedFile file_;
+    BinaryGraphHeader header_{};
+    const uint64_t* offsets_ = nullptr;
+    const int32_t* neighbors_ = nullptr;
+    const int32_t* weights_ = nullptr;
+    const int32_t* edge_ids_ = nullptr;
+    std::vector<uint64_t> owned_offsets_; // Arrays of assign()
+    std::vector<int32_t> owned_neighbors_, owned_weights_;
+
+    bool fail(const std::string& reason, std::string& error) {
+        error = reason;
+        release();
+        return false;
+    }
+
+    // One pass over the mapped arrays, so that neighbors(v) and the BFS/DFS/Dijkstra tools
+    // indexing by the neighbor ids they return stay inside the file: the offsets go from 0
+    // up to arcs without decreasing, every neighbor is a vertex and every edge id an edge.
+    bool validate(const std::string& path, std::string& error) {
+        uint64_t n = header_.n;
+        if (offsets_[0] != 0 || offsets_[n] != header_.arcs) {
+            return fail(path + ": corrupt offsets in binary graph file", error);
+        }
+        for (uint64_t v = 0; v < n; ++v) {
+            if (offsets_[v] > offsets_[v + 1]) {
+                return fail(path + ": corrupt offsets in binary graph file (vertex " + std::to_string(v) + ")", error);
+            }
+        }
+        for (uint64_t i = 0; i < header_.arcs; ++i) {
+            if ((uint32_t)neighbors_[i] >= n) {
+                return fail(path + ": neighbor out of range in binary graph file (arc " + std::to_string(i) + ")", error);
+            }
+        }
+        if (edge_ids_ != nullptr) {
+            for (uint64_t i = 0; i < header_.arcs; ++i) {
+                if (edge_ids_[i] < 0 || (uint64_t)edge_ids_[i] >= header_.m) {
+                    return fail(path + ": edge id out of range in binary graph file (arc " + std::to_string(i) + ")", error);
+                }
+            }
+        }
+        return true;
+    }
+
+    void release() {
+        file_.close();
+        header_ = BinaryGraphHeader();
+        offsets_ = nullptr;
+        neighbors_ = weights_ = edge_ids_ = nullptr;
+        owned_offsets_ = std::vector<uint64_t>();
+        owned_neighbors_ = std::vector<int32_t>();
+        owned_weights_ = std::vector<int32_t>();
+    }
+};
+
+// Returns true if the file starts with the binary graph magic.
+inline bool is_binary_graph_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(GRAPH_MAGIC)];
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, GRAPH_MAGIC, sizeof(magic)) == 0;
+}
+
+// Lays out edges (u, v) as the arcs u -> v and v -> u in CSR form, with a counting pass and
+// a fill pass over the edges in input order, so every row lists its arcs in input order (a
+// loop twice). The weight (weights empty = unweighted) and, with with_edge_ids, the index
+// of every edge go to both of its arcs.
+inline void build_symmetric_csr(int n, const std::vector<std::pair<int, int>>& edges, const std::vector<int>& weights,
+                                bool with_edge_ids, std::vector<uint64_t>& offsets, std::vector<int32_t>& neighbors,
+                                std::vector<int32_t>& arc_weights, std::vector<int32_t>& edge_ids) {
+    offsets.assign(n + 1, 0);
+    for (const auto& e : edges) {
+        offsets[e.first + 1]++;
+        offsets[e.second + 1]++;
+    }
+    for (int v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+
+    uint64_t arcs = offsets[n];
+    neighbors.resize(arcs);
+    arc_weights.resize(weights.empty() ? 0 : arcs);
+    edge_ids.resize(with_edge_ids ? arcs : 0);
+    std::vector<uint64_t> pos(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        int u = edges[i].first, v = edges[i].second;
+        uint64_t a = pos[u]++;
+        uint64_t b = pos[v]++;
+        neighbors[a] = v;
+        neighbors[b] = u;
+        if (!weights.empty()) arc_weights[a] = arc_weights[b] = weights[i];
+        if (with_edge_ids) edge_ids[a] = edge_ids[b] = (int32_t)i;
+    }
+}
+
+// Writes edges (u, v) with optional weights (empty = unweighted) in the binary format.
+inline bool write_binary_graph(const std::string& path, int n, const std::vector<std::pair<int, int>>& edges,
+                               const std::vector<int>& weights, bool with_edge_ids) {
+    std::vector<uint64_t> offsets;
+    std::vector<int32_t> neighbors, arc_weights, edge_ids;
+    build_symmetric_csr(n, edges, weights, with_edge_ids, offsets, neighbors, arc_weights, edge_ids);
+    uint64_t arcs = offsets[n];
+
+    BinaryGraphHeader header{};
+    std::memcpy(header.magic, GRAPH_MAGIC, sizeof(GRAPH_MAGIC));
+    header.version = GRAPH_FORMAT_VERSION;
+    header.flags = (weights.empty() ? 0 : GRAPH_HAS_WEIGHTS) | (with_edge_ids ? GRAPH_HAS_EDGE_IDS : 0);
+    header.n = n;
+    header.m = edges.size();
+    header.arcs = arcs;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) return false;
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)offsets.data(), offsets.size() * sizeof(uint64_t));
+    out.write((const char*)neighbors.data(), neighbors.size() * sizeof(int32_t));
+    out.write((const char*)arc_weights.data(), arc_weights.size() * sizeof(int32_t));
+    out.write((const char*)edge_ids.data(), edge_ids.size() * sizeof(int32_t));
+    return (bool)out;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Order-independent fingerprint of the arc multiset of an undirected graph, for checking
+// that two representations hold the same graph without sorting or printing them.
+// Every edge {u, v} with u != v is the two arcs u -> v and v -> u, and a loop is the single
+// arc u -> u; this is how the adjacency lists, matrices and maps of the represent tools
+// store them. The fingerprint is the number of arcs plus the sum, modulo 2^64, of a 64-bit
+// mix of every arc, so adding arcs commutes, multiplicities count, and a representation can
+// be fingerprinted in one pass over whatever it stores (O(n + m), O(n^2) for a matrix).
+// Arcs are hashed in their direction, so an adjacency structure that lost the reverse of an
+// edge does not match.
+struct GraphFingerprint {
+    uint64_t hash = 0;
+    uint64_t arcs = 0;
+
+    // splitmix64 finalizer over the packed arc
+    static uint64_t mixArc(int u, int v) {
+        uint64_t x = ((uint64_t)(uint32_t)u << 32) | (uint32_t)v;
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // Adds count copies of the arc u -> v.
+    void addArc(int u, int v, uint64_t count = 1) {
+        hash += count * mixArc(u, v);
+        arcs += count;
+    }
+
+    // Adds count copies of the undirected edge {u, v}: both arcs, or one for a loop.
+    void addEdge(int u, int v, uint64_t count = 1) {
+        addArc(u, v, count);
+        if (u != v) addArc(v, u, count);
+    }
+
+    bool operator==(const GraphFingerprint& other) const { return hash == other.hash && arcs == other.arcs; }
+    bool operator!=(const GraphFingerprint& other) const { return !(*this == other); }
+
+    std::string toString() const {
+        char text[48];
+        std::snprintf(text, sizeof(text), "%016llx/%llu", (unsigned long long)hash, (unsigned long long)arcs);
+        return text;
+    }
+};
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "dimacs_csr.h"
+#include "graph_archive.h"
+#include "graph_binary.h"
+#include "mapped_file.h"
+#include "sgb_scan.h"
+#include "text_scan.h"
+
+// ========== UNIFIED GRAPH LOADER ==========
+// load_graph reads a graph file in any of the formats used in this repository into a
+// BinaryGraph, telling the format from the first bytes of the file:
+//   .bin      binary graph of graph_binary.h           magic "NNTGRAPH", used as mapped
+//   .nga      compressed archive of graph_archive.h    magic "NNTGARCH"
+//   SGB       Stanford GraphBase text                  first line "* GraphBase ..."
+//   DIMACS    "p edge n m" and "e u v" lines           first line starts with 'c', 'p' or 'e'
+//   .inp      "n m", then m lines "u v" or "u v w"     first line starts with a number
+// Every text format goes through an in-place parser over the memory-mapped file. The
+// result has the same layout whatever the format, so a tool taking a BinaryGraph::Adjacency
+// or WeightedAdjacency accepts every format:
+//  - .inp and DIMACS edges (u, v) give the arcs u -> v and v -> u in file order, like the
+//    .inp readers of the tools (a loop twice); DIMACS vertices 1..n become 0..n-1, and a
+//    .inp file has weights if its first edge line has three numbers, like in inp2bin;
+//  - SGB arcs and the arcs of a directed archive go through undirected_from_arcs: if every
+//    arc has its reverse with the same label, the file holds an undirected graph arc by
+//    arc (an undirected GraphBase graph, or one written back by SGBGraph::write_archive)
+//    and the arcs are kept, m = arcs / 2; otherwise every arc v -> u is the edge (v, u),
+//    laid out like an .inp edge, m = arcs. Arc labels are the weights;
+//  - a symmetric archive stores every edge at its lower end; the arcs are mirrored back into
+//    sorted rows (a loop twice), with the arc labels as weights.
+// Every tool reading through load_graph works on undirected graphs, so a directed file is
+// read as its underlying undirected multigraph rather than as arcs in one direction only.
+
+enum GraphFormat { GRAPH_FORMAT_UNKNOWN, GRAPH_FORMAT_INP, GRAPH_FORMAT_DIMACS, GRAPH_FORMAT_SGB,
+                   GRAPH_FORMAT_BINARY, GRAPH_FORMAT_ARCHIVE };
+
+inline const char* graph_format_name(GraphFormat format) {
+    switch (format) {
+        case GRAPH_FORMAT_INP: return ".inp";
+        case GRAPH_FORMAT_DIMACS: return "DIMACS";
+        case GRAPH_FORMAT_SGB: return "SGB";
+        case GRAPH_FORMAT_BINARY: return "binary graph";
+        case GRAPH_FORMAT_ARCHIVE: return "graph archive";
+        default: return "unknown";
+    }
+}
+
+// Tells the format of a graph file from its first bytes: a binary magic, or else the first
+// character of the first non-blank line.
+inline GraphFormat detect_graph_format(const char* data, size_t size) {
+    if (size >= sizeof(GRAPH_MAGIC) && std::memcmp(data, GRAPH_MAGIC, sizeof(GRAPH_MAGIC)) == 0) return GRAPH_FORMAT_BINARY;
+    if (size >= sizeof(ARCHIVE_MAGIC) && std::memcmp(data, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) == 0) return GRAPH_FORMAT_ARCHIVE;
+    const char* p = data;
+    const char* end = data + size;
+    while (p < end && (is_text_blank(*p) || *p == '\n')) p++;
+    if (p == end) return GRAPH_FORMAT_UNKNOWN;
+    if (line_starts_with(p, find_line_end(p, end), "* GraphBase")) return GRAPH_FORMAT_SGB;
+    if (*p == 'c' || *p == 'p' || *p == 'e') return GRAPH_FORMAT_DIMACS;
+    if ((unsigned)(*p - '0') < 10 || *p == '-' || *p == '+') return GRAPH_FORMAT_INP;
+    return GRAPH_FORMAT_UNKNOWN;
+}
+
+// Format of the file at path; GRAPH_FORMAT_UNKNOWN if it cannot be read either.
+inline GraphFormat graph_file_format(const std::string& path) {
+    MappedFile file;
+    std::string error;
+    if (!file.open(path, error)) return GRAPH_FORMAT_UNKNOWN;
+    return detect_graph_format(file.data(), file.size());
+}
+
+namespace loader_detail {
+
+inline bool fail(std::string& error, const std::string& path, const std::string& reason, const char* data, const char* line) {
+    error = path + ": " + reason + (line != nullptr ? " at byte offset " + std::to_string(line - data) : "");
+    return false;
+}
+
+// .inp text: "n m" on the first line (the rest of it is ignored), then m edge lines; lines
+// that do not start with a number are skipped. The first number after the edges, if any,
+// is the start vertex of the traversal tools and goes to start (left alone otherwise).
+inline bool load_inp(const std::string& path, const char* data, size_t size, BinaryGraph& graph, int& start,
+                     std::string& error) {
+    const char* p = data;
+    const char* end = data + size;
+    while (p < end && (is_text_blank(*p) || *p == '\n')) p++;
+    const char* line = p;
+    const char* eol = find_line_end(p, end);
+    int n, m;
+    if (!scan_int(p, eol, n) || !scan_int(p, eol, m) || n < 0 || m < 0) {
+        return fail(error, path, "first line must be \"n m\"", data, line);
+    }
+    p = eol + (eol < end ? 1 : 0);
+
+    std::vector<std::pair<int, int>> edges;
+    std::vector<int> weights;
+    edges.reserve(std::min((size_t)m, size / 4 + 1)); // Every edge line takes at least 4 bytes ("0 1\n")
+    bool weighted = false;
+    while ((int)edges.size() < m) {
+        if (p >= end) {
+            std::string reason = "only " + std::to_string(edges.size()) + " of " + std::to_string(m) + " edge lines";
+            return fail(error, path, reason, data, nullptr);
+        }
+        line = p;
+        eol = find_line_end(p, end);
+        p = eol + (eol < end ? 1 : 0);
+        const char* q = line;
+        int u, v, w;
+        if (!scan_int(q, eol, u)) continue; // Blank line
+        if (!scan_int(q, eol, v)) return fail(error, path, "edge line must be \"u v\" or \"u v w\"", data, line);
+        bool has_weight = scan_int(q, eol, w);
+        if (edges.empty()) {
+            weighted = has_weight;
+        } else if (has_weight != weighted) {
+            return fail(error, path, "edge line unlike the first one (with/without weight)", data, line);
+        }
+        if (u < 0 || u >= n || v < 0 || v >= n) return fail(error, path, "vertex out of range in edge line", data, line);
+        edges.push_back({u, v});
+        if (weighted) weights.push_back(w);
+    }
+
+    while (p < end) {
+        eol = find_line_end(p, end);
+        const char* q = p;
+        p = eol + (eol < end ? 1 : 0);
+        if (scan_int(q, eol, start)) break;
+    }
+
+    std::vector<uint64_t> offsets;
+    std::vector<int32_t> neighbors, arc_weights, edge_ids;
+    build_symmetric_csr(n, edges, weights, false, offsets, neighbors, arc_weights, edge_ids);
+    graph.assign(n, m, std::move(offsets), std::move(neighbors), std::move(arc_weights));
+    return true;
+}
+
+// DIMACS through read_dimacs_csr, renumbering the vertices from 0.
+inline bool load_dimacs(const std::string& path, BinaryGraph& graph, std::string& error) {
+    DimacsCSR csr;
+    if (!read_dimacs_csr(path, csr, error)) return false;
+    std::vector<uint64_t> offsets(csr.offset.begin(), csr.offset.end());
+    graph.assign(csr.n, csr.m, std::move(offsets), std::move(csr.neighbor), {});
+    return true;
+}
+
+// Arcs v -> u with labels, grouped by v in increasing order, as an undirected graph; see
+// the top of the file. A loop of an undirected file is two arcs, so loops must pair up too.
+inline void undirected_from_arcs(int n, const std::vector<std::pair<int, int>>& arcs, const std::vector<int>& labels,
+                                 BinaryGraph& graph) {
+    bool labelled = !labels.empty();
+    std::vector<std::tuple<int, int, int>> forward, backward;
+    forward.reserve(arcs.size());
+    backward.reserve(arcs.size());
+    for (size_t i = 0; i < arcs.size(); ++i) {
+        int label = labelled ? labels[i] : 0;
+        forward.emplace_back(arcs[i].first, arcs[i].second, label);
+        backward.emplace_back(arcs[i].second, arcs[i].first, label);
+    }
+    std::sort(forward.begin(), forward.end());
+    std::sort(backward.begin(), backward.end());
+    bool symmetric = forward == backward;
+    for (size_t i = 0; symmetric && i < forward.size();) {
+        size_t j = i + 1;
+        while (j < forward.size() && forward[j] == forward[i]) j++;
+        if (std::get<0>(forward[i]) == std::get<1>(forward[i]) && (j - i) % 2 != 0) symmetric = false;
+        i = j;
+    }
+    forward = std::vector<std::tuple<int, int, int>>();
+    backward = std::vector<std::tuple<int, int, int>>();
+
+    std::vector<uint64_t> offsets;
+    std::vector<int32_t> neighbors, weights, edge_ids;
+    if (symmetric) {
+        offsets.assign(n + 1, 0);
+        neighbors.reserve(arcs.size());
+        for (const auto& arc : arcs) {
+            offsets[arc.first + 1]++;
+            neighbors.push_back(arc.second);
+        }
+        for (int v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+        weights.assign(labels.begin(), labels.end());
+        long long m = arcs.size() / 2;
+        graph.assign(n, m, std::move(offsets), std::move(neighbors), std::move(weights));
+    } else {
+        build_symmetric_csr(n, arcs, labels, false, offsets, neighbors, weights, edge_ids);
+        graph.assign(n, (long long)arcs.size(), std::move(offsets), std::move(neighbors), std::move(weights));
+    }
+}
+
+// SGB through scan_sgb; the chains are followed vertex by vertex, so the arcs come grouped
+// by source.
+inline bool load_sgb(const std::string& path, const char* data, size_t size, BinaryGraph& graph, std::string& error) {
+    SgbArcs sgb;
+    int n = 0;
+    if (!scan_sgb(data, size, [&](std::string_view) { n++; }, sgb, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    std::vector<std::pair<int, int>> arcs;
+    std::vector<int> labels;
+    arcs.reserve(sgb.target.size());
+    labels.reserve(sgb.target.size());
+    int bad_target = -1;
+    bool ok = for_each_sgb_arc(sgb, [&](int v, int target, int label) {
+        if (target < 0 || target >= n) bad_target = v;
+        arcs.push_back({v, target});
+        labels.push_back(label);
+    }, error);
+    if (!ok) {
+        error = path + ": " + error;
+        return false;
+    }
+    if (bad_target >= 0) {
+        error = path + ": arc of vertex " + std::to_string(bad_target) + " leads to no vertex";
+        return false;
+    }
+    undirected_from_arcs(n, arcs, labels, graph);
+    return true;
+}
+
+// Archive rows decoded in order; for_each_arc checks every row against its block and every
+// neighbor against n. A symmetric archive goes straight into the CSR arrays in two decoding
+// passes, like read_dimacs_csr: the first counts both ends of every edge into offsets shifted
+// by two, the second places u -> v and v -> u. Row v gets its lower neighbors while the rows
+// before it are decoded and then its own, so it comes out sorted; the mirrored arcs are
+// scattered writes, the price of storing every edge once. A directed archive goes through
+// undirected_from_arcs.
+inline bool load_archive(const std::string& path, BinaryGraph& graph, std::string& error) {
+    GraphArchive archive;
+    if (!archive.open(path, error)) return false;
+    int n = archive.n();
+    bool labelled = archive.has_arc_labels();
+    if (!archive.symmetric()) {
+        std::vector<std::pair<int, int>> arcs;
+        std::vector<int> labels;
+        arcs.reserve(archive.arcs());
+        if (labelled) labels.reserve(archive.arcs());
+        bool ok = archive.for_each_arc([&](int v, int u, int label) {
+            arcs.push_back({v, u});
+            if (labelled) labels.push_back(label);
+        }, error);
+        if (!ok) return false;
+        undirected_from_arcs(n, arcs, labels, graph);
+        return true;
+    }
+
+    std::vector<uint64_t> offsets((size_t)n + 2, 0);
+    bool ok = archive.for_each_arc([&](int v, int u, int) {
+        offsets[v + 2]++;
+        offsets[u + 2]++;
+    }, error);
+    if (!ok) return false;
+    for (int v = 0; v < n; ++v) offsets[v + 2] += offsets[v + 1];
+
+    // offsets[v + 1] is the fill position of row v, and ends up as its end
+    std::vector<int32_t> neighbors(offsets[n + 1]), weights(labelled ? offsets[n + 1] : 0);
+    ok = archive.for_each_arc([&](int v, int u, int label) {
+        uint64_t at_v = offsets[v + 1]++, at_u = offsets[u + 1]++;
+        neighbors[at_v] = u;
+        neighbors[at_u] = v;
+        if (labelled) weights[at_v] = weights[at_u] = label;
+    }, error);
+    if (!ok) return false;
+    offsets.pop_back();
+    graph.assign(n, (long long)archive.m(), std::move(offsets), std::move(neighbors), std::move(weights));
+    return true;
+}
+
+} // namespace loader_detail
+
+// What load_graph learns about a file besides the graph.
+struct GraphFileInfo {
+    GraphFormat format = GRAPH_FORMAT_UNKNOWN;
+    int start = -1; // Start vertex on the line after the edges of an .inp file, -1 if none
+};
+
+// Loads the graph file at path, in whichever format it is, into graph. On failure error
+// holds the reason (with the byte offset of a malformed text line) and graph is unchanged
+// or empty. If info is given, it receives the detected format and the stored start vertex.
+inline bool load_graph(const std::string& path, BinaryGraph& graph, std::string& error, GraphFileInfo* info = nullptr) {
+    MappedFile file;
+    if (!file.open(path, error)) return false;
+    GraphFileInfo found;
+    found.format = detect_graph_format(file.data(), file.size());
+    bool ok;
+    switch (found.format) {
+        case GRAPH_FORMAT_BINARY:
+            file.close();
+            ok = graph.open(path, error);
+            break;
+        case GRAPH_FORMAT_ARCHIVE:
+            file.close();
+            ok = loader_detail::load_archive(path, graph, error);
+            break;
+        case GRAPH_FORMAT_DIMACS:
+            file.close();
+            ok = loader_detail::load_dimacs(path, graph, error);
+            break;
+        case GRAPH_FORMAT_SGB:
+            ok = loader_detail::load_sgb(path, file.data(), file.size(), graph, error);
+            break;
+        case GRAPH_FORMAT_INP:
+            ok = loader_detail::load_inp(path, file.data(), file.size(), graph, found.start, error);
+            break;
+        default:
+            error = path + ": unknown graph file format";
+            ok = false;
+    }
+    if (info != nullptr) *info = found;
+    return ok;
+}
+
+// Start vertex of a traversal of a loaded graph with n vertices: the command-line argument
+// arg if given, else the one stored in the file. what names it in the errors, e.g.
+// "starting vertex".
+inline bool choose_start_vertex(const char* arg, const GraphFileInfo& info, int n, const char* what, int& start,
+                                std::string& error) {
+    start = info.start;
+    if (arg != nullptr) {
+        char* end;
+        long value = std::strtol(arg, &end, 10);
+        if (end == arg || *end != '\0' || value < INT32_MIN || value > INT32_MAX) {
+            error = std::string(what) + " must be a number, not \"" + arg + "\"";
+            return false;
+        }
+        start = (int)value;
+    } else if (start < 0) {
+        error = std::string("no ") + what + ": give it after the graph file, or on the line after the edges of an .inp file";
+        return false;
+    }
+    if (start < 0 || start >= n) {
+        error = std::string(what) + " must be in [0, " + std::to_string(n - 1) + "]";
+        return false;
+    }
+    return true;
+}
+
+// Removes the loops of a loaded graph, for the tools on graphs without loops, calling
+// on_loop(v) once for every loop at v, in increasing v; a loop is two arcs in the row of v.
+// The arrays are rebuilt only if there is a loop, so a mapped .bin file without any stays
+// mapped; the rebuilt graph has no edge ids, and m drops by the number of loops.
+template <typename OnLoop>
+void remove_loops(BinaryGraph& graph, OnLoop on_loop) {
+    int n = graph.n();
+    uint64_t loop_arcs = 0;
+    for (int v = 0; v < n; ++v) {
+        for (int u : graph.neighbors(v)) loop_arcs += u == v;
+    }
+    if (loop_arcs == 0) return;
+
+    bool weighted = graph.has_weights();
+    std::vector<uint64_t> offsets(n + 1, 0);
+    std::vector<int32_t> neighbors, weights;
+    long long loops = 0;
+    for (int v = 0; v < n; ++v) {
+        NeighborRange row = graph.neighbors(v);
+        long long at_v = 0;
+        for (int k = 0; k < row.size(); ++k) {
+            if (row[k] == v) {
+                at_v++;
+                continue;
+            }
+            neighbors.push_back(row[k]);
+            if (weighted) weights.push_back(graph.weighted_neighbors(v)[k].second);
+        }
+        offsets[v + 1] = neighbors.size();
+        for (long long k = 0; k < (at_v + 1) / 2; ++k) on_loop(v);
+        loops += (at_v + 1) / 2;
+    }
+    graph.assign(n, graph.m() - loops, std::move(offsets), std::move(neighbors), std::move(weights));
+}
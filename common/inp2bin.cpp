@@ -0,0 +1,77 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "graph_binary.h"
+
+// Converts a graph from the .inp text format of the BFS/DFS/Dijkstra/represent tools
+// ("n m", then m lines "u v" or "u v w", then an optional start vertex, which is ignored)
+// to the binary format of graph_binary.h.
+// Weights are detected from the number of numbers on the first edge line.
+// Usage: inp2bin <input.inp> <output.bin> [--edge-ids]
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Cach dung: " << argv[0] << " <input.inp> <output.bin> [--edge-ids]\n";
+        return 1;
+    }
+    bool with_edge_ids = argc > 3 && string(argv[3]) == "--edge-ids";
+
+    ifstream in(argv[1]);
+    if (!in.is_open()) {
+        cerr << "Loi: Khong mo duoc file " << argv[1] << "\n";
+        return 1;
+    }
+    long long n, m;
+    if (!(in >> n >> m) || n < 0 || m < 0 || n > INT32_MAX) {
+        cerr << "Loi: Dong dau tien phai la \"n m\"\n";
+        return 1;
+    }
+
+    vector<pair<int, int>> edges;
+    vector<int> weights;
+    edges.reserve(m);
+    bool weighted = false;
+    string line;
+    getline(in, line); // Rest of the first line
+    for (long long i = 0; i < m;) {
+        if (!getline(in, line)) {
+            cerr << "Loi: File chi co " << i << " canh, can " << m << " canh\n";
+            return 1;
+        }
+        istringstream tokens(line);
+        long long u, v, w;
+        if (!(tokens >> u)) continue; // Blank line
+        if (!(tokens >> v)) {
+            cerr << "Loi: Dong canh thu " << i + 1 << " phai la \"u v\" hoac \"u v w\"\n";
+            return 1;
+        }
+        bool has_weight = (bool)(tokens >> w);
+        if (i == 0) {
+            weighted = has_weight;
+        } else if (has_weight != weighted) {
+            cerr << "Loi: Canh thu " << i + 1 << " khong cung dang voi canh dau tien (co/khong co trong so)\n";
+            return 1;
+        }
+        if (u < 0 || u >= n || v < 0 || v >= n) {
+            cerr << "Loi: Canh (" << u << "," << v << ") khong hop le. Dinh phai nam trong khoang [0, " << n - 1 << "]\n";
+            return 1;
+        }
+        edges.push_back({(int)u, (int)v});
+        if (weighted) weights.push_back((int)w);
+        i++;
+    }
+
+    if (!write_binary_graph(argv[2], (int)n, edges, weights, with_edge_ids)) {
+        cerr << "Loi: Khong ghi duoc file " << argv[2] << "\n";
+        return 1;
+    }
+    cerr << "Da ghi " << n << " dinh, " << m << " canh" << (weighted ? " (co trong so)" : "")
+         << " vao " << argv[2] << "\n";
+    return 0;
+}
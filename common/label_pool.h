@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Interned string storage for vertex labels.
+// All distinct labels are stored back to back in one arena, label id i being
+// arena[offset[i] .. offset[i + 1]), so a label costs its characters plus one offset and
+// an equal label is stored once, however often it appears. intern() finds equal labels
+// through an open-addressing table with linear probing whose slots pack the high half of
+// the label hash with the id, so a probe only reads the arena on a likely match, and the
+// table keeps no pointers into the arena, which can grow freely. The string_views handed
+// out point into the arena and stay valid until the next intern() or clear().
+class LabelPool {
+public:
+    LabelPool() { clear(); }
+
+    // Id of label, adding it if it is new. Ids are 0, 1, 2, ... in order of first appearance.
+    int intern(std::string_view label) {
+        uint64_t h = std::hash<std::string_view>()(label);
+        uint64_t tag = h >> 32 << 32;
+        size_t mask = slot_.size() - 1;
+        size_t s = h & mask;
+        for (; slot_[s] != 0; s = (s + 1) & mask) {
+            if ((slot_[s] & ~ID_MASK) == tag && (*this)[slot_id(s)] == label) return slot_id(s);
+        }
+
+        int id = size();
+        arena_.append(label.data(), label.size());
+        offset_.push_back(arena_.size());
+        slot_[s] = tag | (uint64_t)(id + 1);
+        if (2 * (size_t)size() > slot_.size()) rehash(2 * slot_.size());
+        return id;
+    }
+
+    std::string_view operator[](int id) const {
+        return std::string_view(arena_.data() + offset_[id], offset_[id + 1] - offset_[id]);
+    }
+
+    // Number of distinct labels.
+    int size() const { return (int)offset_.size() - 1; }
+
+    // Heap bytes held by the pool.
+    size_t bytes() const {
+        return arena_.capacity() + offset_.capacity() * sizeof(uint64_t) + slot_.capacity() * sizeof(uint64_t);
+    }
+
+    void clear() {
+        arena_.clear();
+        offset_.assign(1, 0);
+        slot_.assign(16, 0);
+    }
+
+    // Makes room for the given number of distinct labels and arena characters.
+    void reserve(int labels, size_t characters) {
+        arena_.reserve(characters);
+        offset_.reserve(labels + 1);
+        size_t slots = slot_.size();
+        while (slots < 2 * (size_t)labels) slots *= 2;
+        if (slots != slot_.size()) rehash(slots);
+    }
+
+private:
+    static const uint64_t ID_MASK = 0xffffffffULL;
+
+    std::string arena_;
+    std::vector<uint64_t> offset_; // size() + 1 entries
+    std::vector<uint64_t> slot_;   // (hash >> 32) << 32 | (id + 1), 0 for empty; a power of two, at most half full
+
+    int slot_id(size_t s) const { return (int)(slot_[s] & ID_MASK) - 1; }
+
+    // Rebuilds the table with the given number of slots, hashing the labels again.
+    void rehash(size_t slots) {
+        slot_.assign(slots, 0);
+        size_t mask = slots - 1;
+        for (int id = 0; id < size(); ++id) {
+            uint64_t h = std::hash<std::string_view>()((*this)[id]);
+            size_t s = h & mask;
+            while (slot_[s] != 0) s = (s + 1) & mask;
+            slot_[s] = (h >> 32 << 32) | (uint64_t)(id + 1);
+        }
+    }
+};
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "graph_loader.h"
+#include "graph_fingerprint.h"
+#include "triangles.h"
+
+// ========== REPRESENT BATCH MODE ==========
+// The --batch mode of represent_simple, represent_multi and represent_general:
+//   <tool> --batch <graph file> <chain> [output] [--threads N] [--footprint] [--no-verify] [--triangles]
+// The input file has the same format as the interactive input ("n m" then m lines "u v").
+// It may also be a DIMACS, SGB, binary (.bin, see common/inp2bin) or archive (.nga) file;
+// the format is told from the first bytes by graph_loader.h.
+// <chain> is a comma separated list of representations (AL, AM, EAL, AMap) starting from
+// the Adjacency List, e.g. "AL,AM,EAL,AMap". Only the final representation is written
+// (to stdout when no output file is given); nothing is displayed in between and the
+// per-step timings are reported on stderr.
+// Every step also reports the footprint of its result. With --footprint the graph is first
+// built in each of the four representations, one at a time, and a table of their footprints
+// is printed on stderr with the smallest one recommended.
+// After every step the fingerprint of the new representation is compared with the one of
+// the input graph, and the run stops with an error if a conversion changed the graph;
+// --no-verify skips the check.
+// With --triangles the triangles and clustering coefficients of the final representation
+// are computed; the totals go to stderr and the per-vertex values follow the representation.
+// --threads N exists only in the tools with parallel conversion kernels (N = 0: all
+// hardware threads).
+//
+// The driver is run_represent_batch<Tool>. Tool derives from RepresentBatchTool and names
+// the tool's types: Rep, its Representation enum (AL, AM, EAL, AMap in this order), and
+// List, Matrix, Extended and Map. For each of the four types the tool defines the twelve
+// conversions (listToMatrix, ..., mapToExtended), displayX(x, out), footprintBytes(x),
+// fingerprintOf(x) and trianglesOf(x), and getRepName(Rep); they are found by argument
+// dependent lookup when the driver is instantiated, so the header can be included first.
+// What differs between the tools is given by the members RepresentBatchTool lists.
+
+// Defaults of the tool description; a tool hides the members it changes.
+struct RepresentBatchTool {
+    static constexpr const char* graph_kind = "do thi"; // Ends the advice "nho nhat cho <graph_kind> nay"
+
+    // The CSR arrays of the loaded formats and the .inp edges list a loop u u twice in adj[u],
+    // as the interactive input does; a tool whose conversions expect it once keeps one.
+    static constexpr bool loops_listed_once = false;
+
+    // Returns false, with the error printed, for an input edge the tool does not accept.
+    static bool check_edge(int, int) { return true; }
+
+    // More rows of the --footprint table, after the four representations.
+    template <class List>
+    static void print_extra_footprint(const List&) {}
+
+    // --threads N: set_threads(N), then convert_parallel(graph, to) for every step.
+    static constexpr bool has_threads_option = false;
+    static void set_threads(int) {}
+    template <class Graph, class Rep>
+    static void convert_parallel(Graph&, Rep) {}
+};
+
+// Holds the graph in one representation at a time; the previous one is released after each step.
+template <class Tool>
+struct RepresentBatchGraph {
+    typename Tool::Rep rep = typename Tool::Rep(0);
+    typename Tool::List list;
+    typename Tool::Matrix matrix;
+    typename Tool::Extended extended;
+    typename Tool::Map map;
+};
+
+namespace represent_batch_detail {
+
+// Parses a representation name used in the conversion chain.
+template <class Rep>
+bool parse_rep_name(const std::string& name, Rep& rep) {
+    static const char* const names[] = {"AL", "AM", "EAL", "AMap"};
+    for (int i = 0; i < 4; i++) {
+        if (name == names[i]) {
+            rep = Rep(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void print_range_error(int u, int v, int n) {
+    std::cerr << "Loi: Canh (" << u << "," << v << ") khong hop le. Dinh phai nam trong khoang [0, " << n - 1 << "]\n";
+}
+
+// Reads a graph file that is not .inp through load_graph. A .bin file is memory-mapped, and
+// the CSR arrays of every format hold the adjacency lists in input order, so they are copied
+// without parsing; only the vertex range and check_edge are checked. A loop is two
+// consecutive arcs u -> u there, and with loops_listed_once only the first of each pair is kept.
+template <class Tool>
+bool read_loaded_graph_file(const std::string& path, typename Tool::List& list) {
+    BinaryGraph graph;
+    std::string error;
+    if (!load_graph(path, graph, error)) {
+        std::cerr << "Loi: " << error << "\n";
+        return false;
+    }
+    list.n = graph.n();
+    list.adj.assign(list.n, std::vector<int>());
+    for (int u = 0; u < list.n; u++) {
+        NeighborRange neighbors = graph.neighbors(u);
+        for (int v : neighbors) {
+            if (v < 0 || v >= list.n) {
+                print_range_error(u, v, list.n);
+                return false;
+            }
+            if (!Tool::check_edge(u, v)) return false;
+        }
+        if (!Tool::loops_listed_once) {
+            list.adj[u].assign(neighbors.begin(), neighbors.end());
+            continue;
+        }
+        list.adj[u].reserve(neighbors.size());
+        bool loop_pending = false;
+        for (int v : neighbors) {
+            if (v == u) {
+                loop_pending = !loop_pending;
+                if (!loop_pending) continue; // Second arc of the loop
+            }
+            list.adj[u].push_back(v);
+        }
+    }
+    return true;
+}
+
+// Reads a graph file into an Adjacency List, with the same validation as the interactive input.
+template <class Tool>
+bool read_graph_file(const std::string& path, typename Tool::List& list) {
+    if (graph_file_format(path) != GRAPH_FORMAT_INP) return read_loaded_graph_file<Tool>(path, list);
+
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Loi: Khong mo duoc file " << path << "\n";
+        return false;
+    }
+    int n, m;
+    if (!(in >> n >> m) || n < 0 || m < 0) {
+        std::cerr << "Loi: Dong dau tien phai la \"n m\"\n";
+        return false;
+    }
+    list.n = n;
+    list.adj.assign(n, std::vector<int>());
+    for (int i = 0; i < m; i++) {
+        int u, v;
+        if (!(in >> u >> v)) {
+            std::cerr << "Loi: File chi co " << i << " canh, can " << m << " canh\n";
+            return false;
+        }
+        if (u < 0 || u >= n || v < 0 || v >= n) {
+            print_range_error(u, v, n);
+            return false;
+        }
+        if (!Tool::check_edge(u, v)) return false;
+        list.adj[u].push_back(v);
+        if (u != v || !Tool::loops_listed_once) list.adj[v].push_back(u); // Undirected graph
+    }
+    return true;
+}
+
+// Applies one of the 12 conversions in place.
+template <class Tool>
+void convert_batch_graph(RepresentBatchGraph<Tool>& g, typename Tool::Rep to) {
+    using Rep = typename Tool::Rep;
+    const Rep AL = Rep(0), AM = Rep(1), EAL = Rep(2);
+    if (g.rep == to) return;
+    switch ((int)g.rep) {
+        case 0:
+            if (to == AM) g.matrix = listToMatrix(g.list);
+            else if (to == EAL) g.extended = listToExtended(g.list);
+            else g.map = listToMap(g.list);
+            g.list = typename Tool::List();
+            break;
+        case 1:
+            if (to == AL) g.list = matrixToList(g.matrix);
+            else if (to == EAL) g.extended = matrixToExtended(g.matrix);
+            else g.map = matrixToMap(g.matrix);
+            g.matrix = typename Tool::Matrix();
+            break;
+        case 2:
+            if (to == AL) g.list = extendedToList(g.extended);
+            else if (to == AM) g.matrix = extendedToMatrix(g.extended);
+            else g.map = extendedToMap(g.extended);
+            g.extended = typename Tool::Extended();
+            break;
+        case 3:
+            if (to == AL) g.list = mapToList(g.map);
+            else if (to == AM) g.matrix = mapToMatrix(g.map);
+            else g.extended = mapToExtended(g.map);
+            g.map = typename Tool::Map();
+            break;
+    }
+    g.rep = to;
+}
+
+// Calls f with the representation the graph is currently in.
+template <class Tool, class F>
+auto visit_batch_graph(const RepresentBatchGraph<Tool>& g, F f) {
+    switch ((int)g.rep) {
+        case 1: return f(g.matrix);
+        case 2: return f(g.extended);
+        case 3: return f(g.map);
+        default: return f(g.list);
+    }
+}
+
+// Writes the representation the graph is currently in, using the display format.
+template <class Tool>
+void write_batch_graph(const RepresentBatchGraph<Tool>& g, std::ostream& out) {
+    switch ((int)g.rep) {
+        case 0: displayList(g.list, out); break;
+        case 1: displayMatrix(g.matrix, out); break;
+        case 2: displayExtended(g.extended, out); break;
+        case 3: displayMap(g.map, out); break;
+    }
+}
+
+// Writes the triangles through every vertex and its clustering coefficient.
+inline void write_triangles(const TriangleStats& stats, std::ostream& out) {
+    out << "Triangles: " << stats.triangles << " (with multiplicities: " << stats.instances << ")\n";
+    out << "Average clustering: " << stats.average_clustering << ", Transitivity: " << stats.transitivity << "\n";
+    for (int v = 0; v < (int)stats.per_vertex.size(); v++) {
+        out << v << ": triangles = " << stats.per_vertex[v] << ", clustering = " << stats.clustering[v] << "\n";
+    }
+}
+
+// Builds every representation from the Adjacency List, one at a time so that only one extra
+// copy is alive, and prints the footprint table with the smallest representation.
+template <class Tool>
+void print_footprint_table(const typename Tool::List& list) {
+    using Rep = typename Tool::Rep;
+    size_t bytes[4];
+    bytes[0] = footprintBytes(list);
+    bytes[1] = footprintBytes(listToMatrix(list));
+    bytes[2] = footprintBytes(listToExtended(list));
+    bytes[3] = footprintBytes(listToMap(list));
+
+    int best = 0;
+    std::cerr << "Bo nho (" << list.n << " dinh):\n";
+    for (int rep = 0; rep < 4; rep++) {
+        std::cerr << "  " << std::left << std::setw(32) << getRepName(Rep(rep)) << std::right << std::setw(14)
+                  << bytes[rep] << " bytes\n";
+        if (bytes[rep] < bytes[best]) best = rep;
+    }
+    Tool::print_extra_footprint(list);
+    std::cerr << "Nen dung: " << getRepName(Rep(best)) << " (nho nhat cho " << Tool::graph_kind << " nay)\n";
+}
+
+inline double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace represent_batch_detail
+
+// Runs "--batch" (argv[1]) with the arguments described at the top.
+template <class Tool>
+int run_represent_batch(int argc, char* argv[]) {
+    using namespace represent_batch_detail;
+    using Rep = typename Tool::Rep;
+    auto usage = [&]() {
+        std::cerr << "Cach dung: " << argv[0] << " --batch <graph file> <AL,AM,EAL,AMap,...> [output] "
+                  << (Tool::has_threads_option ? "[--threads N] " : "") << "[--footprint] [--no-verify] [--triangles]\n";
+        return 1;
+    };
+    if (argc < 4) return usage();
+
+    std::string output_path;
+    bool footprint = false;
+    bool verify = true;
+    bool triangles = false;
+    bool parallel = false;
+    for (int i = 4; i < argc; i++) {
+        std::string arg = argv[i];
+        if (Tool::has_threads_option && arg == "--threads") {
+            // The value must be there and be a whole number; otherwise it would be taken as the output path
+            char* end = nullptr;
+            long threads = i + 1 < argc ? std::strtol(argv[i + 1], &end, 10) : -1;
+            if (i + 1 >= argc || end == argv[i + 1] || *end != '\0' || threads < 0 || threads > 1024) {
+                std::cerr << "Loi: --threads can mot so nguyen tu 0 den 1024\n";
+                return usage();
+            }
+            Tool::set_threads((int)threads);
+            parallel = true;
+            i++;
+        } else if (arg == "--footprint") {
+            footprint = true;
+        } else if (arg == "--no-verify") {
+            verify = false;
+        } else if (arg == "--triangles") {
+            triangles = true;
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Loi: Tuy chon khong hop le: " << arg << "\n";
+            return usage();
+        } else {
+            output_path = arg;
+        }
+    }
+
+    std::vector<Rep> chain;
+    std::stringstream chain_ss(argv[3]);
+    std::string name;
+    while (std::getline(chain_ss, name, ',')) {
+        Rep rep;
+        if (!parse_rep_name(name, rep)) {
+            std::cerr << "Loi: Bieu dien \"" << name << "\" khong hop le (dung AL, AM, EAL, AMap)\n";
+            return 1;
+        }
+        chain.push_back(rep);
+    }
+
+    RepresentBatchGraph<Tool> g;
+    auto start = std::chrono::steady_clock::now();
+    if (!read_graph_file<Tool>(argv[2], g.list)) return 1;
+    std::cerr << "Doc file: " << elapsed_ms(start) << " ms, " << footprintBytes(g.list) << " bytes\n";
+    GraphFingerprint input_fingerprint;
+    if (verify) {
+        input_fingerprint = fingerprintOf(g.list);
+        std::cerr << "Fingerprint: " << input_fingerprint.toString() << "\n";
+    }
+    if (footprint) print_footprint_table<Tool>(g.list);
+
+    for (size_t i = 0; i < chain.size(); i++) {
+        Rep from = g.rep;
+        start = std::chrono::steady_clock::now();
+        if (parallel) Tool::convert_parallel(g, chain[i]);
+        else convert_batch_graph(g, chain[i]);
+        std::cerr << "Buoc " << i + 1 << ": " << getRepName(from) << " -> " << getRepName(chain[i]) << ": "
+                  << elapsed_ms(start) << " ms, "
+                  << visit_batch_graph(g, [](const auto& x) { return footprintBytes(x); }) << " bytes\n";
+        if (verify) {
+            GraphFingerprint step_fingerprint = visit_batch_graph(g, [](const auto& x) { return fingerprintOf(x); });
+            if (step_fingerprint != input_fingerprint) {
+                std::cerr << "Loi: Buoc " << i + 1 << " lam thay doi do thi (fingerprint " << step_fingerprint.toString()
+                          << ", can " << input_fingerprint.toString() << ")\n";
+                return 1;
+            }
+        }
+    }
+
+    TriangleStats triangle_stats;
+    if (triangles) {
+        start = std::chrono::steady_clock::now();
+        triangle_stats = visit_batch_graph(g, [](const auto& x) { return trianglesOf(x); });
+        std::cerr << "Tam giac: " << triangle_stats.triangles << " (tinh ca canh boi: " << triangle_stats.instances
+                  << "), he so phan cum trung binh: " << triangle_stats.average_clustering << ": "
+                  << elapsed_ms(start) << " ms\n";
+    }
+
+    start = std::chrono::steady_clock::now();
+    if (!output_path.empty()) {
+        std::ofstream out(output_path);
+        if (!out.is_open()) {
+            std::cerr << "Loi: Khong ghi duoc file " << output_path << "\n";
+            return 1;
+        }
+        write_batch_graph(g, out);
+        if (triangles) write_triangles(triangle_stats, out);
+    } else {
+        std::ios::sync_with_stdio(false);
+        write_batch_graph(g, std::cout);
+        if (triangles) write_triangles(triangle_stats, std::cout);
+    }
+    std::cerr << "Ghi ket qua: " << elapsed_ms(start) << " ms\n";
+    return 0;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "text_scan.h"
+
+// ========== SGB SCANNER ==========
+// Shared by SGBGraph::read_sgb of Project_4/BT5/E_1_2.cpp and by graph_loader.h. scan_sgb
+// reads a GraphBase file in one pass over its memory mapping, without line buffers or
+// streams. The sections are the ones the original line-based reader looked for:
+//  - the first non-empty line starts with "* GraphBase"; lines up to "* Vertices" are skipped;
+//  - every line up to "* Arcs" is a vertex "label,Ai,...", where Ai is the first arc of the
+//    vertex (1-based, 0 for none) and the label runs up to the first comma;
+//  - every line up to "* Checksum" is arc number 1, 2, ... in the form "V j,Ai,label,...",
+//    where j is the target and Ai the next arc of the same source vertex.
+// Empty lines are skipped, and a '\r' before the line end is ignored.
+
+// The arcs of a GraphBase file in flat arrays indexed by arc number: arc i is entry i - 1.
+struct SgbArcs {
+    std::vector<int> first_arc; // First arc of every vertex, 0 for none
+    std::vector<int> target, next, label;
+};
+
+// Scans the GraphBase text [data, data + size), calling on_vertex(label) for every vertex
+// line in order and collecting the arcs. On failure error holds the reason, with the byte
+// offset of a malformed line.
+template <typename OnVertex>
+bool scan_sgb(const char* data, size_t size, OnVertex on_vertex, SgbArcs& arcs, std::string& error) {
+    const char* p = data;
+    const char* end = data + size;
+
+    enum Section { START, PREAMBLE, VERTICES, ARCS, CHECKSUM } section = START;
+    bool have_vertices = false, have_arcs = false;
+    arcs = SgbArcs();
+    auto fail = [&](const char* reason, const char* line) {
+        error = std::string(reason) + (line != nullptr ? " at byte offset " + std::to_string(line - data) : "");
+        return false;
+    };
+
+    while (p < end && section != CHECKSUM) {
+        const char* line = p;
+        const char* eol = find_line_end(p, end);
+        p = eol + (eol < end ? 1 : 0);
+        const char* text_end = eol > line && eol[-1] == '\r' ? eol - 1 : eol;
+        if (text_end == line) continue;
+
+        if (section == START) {
+            if (!line_starts_with(line, text_end, "* GraphBase")) return fail("not a GraphBase file", line);
+            section = PREAMBLE;
+        } else if (line_equals(line, text_end, "* Vertices")) {
+            section = VERTICES;
+            have_vertices = true;
+        } else if (line_equals(line, text_end, "* Arcs")) {
+            section = ARCS;
+            have_arcs = true;
+        } else if (line_starts_with(line, text_end, "* Checksum")) {
+            section = CHECKSUM;
+        } else if (section == VERTICES) {
+            const char* comma = (const char*)std::memchr(line, ',', text_end - line);
+            const char* q = comma + 1;
+            int Ai;
+            if (comma == nullptr || !scan_int(q, text_end, Ai)) return fail("malformed vertex line", line);
+            on_vertex(std::string_view(line, comma - line));
+            arcs.first_arc.push_back(Ai);
+        } else if (section == ARCS) {
+            const char* q = line;
+            int tgt, Ai, label;
+            bool ok = skip_word(q, text_end) && scan_int(q, text_end, tgt);
+            ok = ok && q++ < text_end && scan_int(q, text_end, Ai); // Skip the comma
+            ok = ok && q++ < text_end && scan_int(q, text_end, label);
+            if (!ok) return fail("malformed arc line", line);
+            arcs.target.push_back(tgt);
+            arcs.next.push_back(Ai);
+            arcs.label.push_back(label);
+        }
+    }
+    if (!have_vertices || !have_arcs || section != CHECKSUM) {
+        return fail("missing \"* Vertices\", \"* Arcs\" or \"* Checksum\" line", nullptr);
+    }
+    return true;
+}
+
+// Follows the arc chain of every vertex v in order, calling visit(v, target, label) for
+// every arc in chain order. Every arc is on at most one chain, so a chain longer than the
+// arc count has a cycle; a chain that leaves the arcs or cycles is an error.
+template <typename Visit>
+bool for_each_sgb_arc(const SgbArcs& arcs, Visit visit, std::string& error) {
+    int count = arcs.target.size();
+    for (int v = 0; v < (int)arcs.first_arc.size(); ++v) {
+        int steps = 0;
+        for (int i = arcs.first_arc[v]; i != 0; i = arcs.next[i - 1]) {
+            if (i < 0 || i > count || ++steps > count) {
+                error = "broken arc chain of vertex " + std::to_string(v);
+                return false;
+            }
+            visit(v, arcs.target[i - 1], arcs.label[i - 1]);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+// Scanning helpers for the text graph readers, which parse a memory-mapped file in place.
+// Every helper works on one line [p, end), where end is the '\n' or the end of the file,
+// and never reads past end.
+
+// Blanks inside a line, including '\r' so that files with CRLF line ends read the same.
+inline bool is_text_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// End of the line starting at p: its '\n', or end if it is the last line without one.
+inline const char* find_line_end(const char* p, const char* end) {
+    const char* eol = (const char*)std::memchr(p, '\n', end - p);
+    return eol == nullptr ? end : eol;
+}
+
+// Skips blanks, then parses an optionally signed decimal int at p, like operator>> of a
+// stream. On success p points just after the last digit; fails on no digits or overflow.
+inline bool scan_int(const char*& p, const char* end, int& value) {
+    while (p < end && is_text_blank(*p)) p++;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+    const char* digits = p;
+    uint64_t x = 0;
+    while (p < end && (unsigned)(*p - '0') < 10 && x <= (uint64_t)INT_MAX + 1) {
+        x = x * 10 + (unsigned)(*p++ - '0');
+    }
+    if (p == digits || (p < end && (unsigned)(*p - '0') < 10)) return false; // No digits, or too long
+    if (x > (uint64_t)INT_MAX + (negative ? 1 : 0)) return false;
+    value = (int)(negative ? -(long long)x : (long long)x);
+    return true;
+}
+
+// Skips blanks and one word of non-blank characters; fails if there is no word before end.
+inline bool skip_word(const char*& p, const char* end) {
+    while (p < end && is_text_blank(*p)) p++;
+    const char* word = p;
+    while (p < end && *p != '\n' && !is_text_blank(*p)) p++;
+    return p != word;
+}
+
+// True if the line [p, end) starts with prefix.
+inline bool line_starts_with(const char* p, const char* end, const char* prefix) {
+    size_t length = std::strlen(prefix);
+    return (size_t)(end - p) >= length && std::memcmp(p, prefix, length) == 0;
+}
+
+// True if the line [p, end), without a trailing '\r', is exactly text.
+inline bool line_equals(const char* p, const char* end, const char* text) {
+    if (end > p && end[-1] == '\r') end--;
+    size_t length = std::strlen(text);
+    return (size_t)(end - p) == length && std::memcmp(p, text, length) == 0;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Buffered text output for the graph file writers.
+// Text is appended to a large reusable buffer, integers are formatted with std::to_chars
+// straight into it (no locale, no stream state), and the buffer goes to the file in blocks of
+// TEXT_WRITER_BLOCK bytes. The output is byte for byte what the same sequence of
+// ofstream << calls writes: the file is opened in text mode as well, so line ends are
+// translated the same way on every platform.
+
+// Bytes collected before the buffer is written to the file.
+const size_t TEXT_WRITER_BLOCK = 1 << 22;
+// Items a thread formats per round in write_lines.
+const size_t TEXT_WRITER_ITEMS_PER_ROUND = 1 << 16;
+
+// Growable text buffer with stream-like appends. Appends only check the capacity; integers
+// are formatted in place.
+class TextBuffer {
+public:
+    TextBuffer& operator<<(std::string_view s) {
+        char* p = room(s.size());
+        std::memcpy(p, s.data(), s.size());
+        size_ += s.size();
+        return *this;
+    }
+    TextBuffer& operator<<(const std::string& s) { return *this << std::string_view(s); }
+    TextBuffer& operator<<(const char* s) { return *this << std::string_view(s); }
+    TextBuffer& operator<<(char c) {
+        *room(1) = c;
+        size_++;
+        return *this;
+    }
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    TextBuffer& operator<<(T x) {
+        char* p = room(24);
+        size_ = std::to_chars(p, p + 24, x).ptr - text_.data();
+        return *this;
+    }
+
+    const char* data() const { return text_.data(); }
+    size_t size() const { return size_; }
+    void clear() { size_ = 0; } // Keeps the capacity for the next block
+    void reserve(size_t bytes) {
+        if (bytes > text_.size()) text_.resize(bytes);
+    }
+
+private:
+    std::vector<char> text_; // Capacity; the text is text_[0 .. size_)
+    size_t size_ = 0;
+
+    // Returns where the next bytes go, with room for at least 'bytes' of them.
+    char* room(size_t bytes) {
+        if (size_ + bytes > text_.size()) text_.resize(std::max(2 * text_.size(), size_ + bytes + 4096));
+        return text_.data() + size_;
+    }
+};
+
+// A text file written through a TextBuffer.
+class TextWriter {
+public:
+    TextWriter() { buffer_.reserve(TEXT_WRITER_BLOCK + 4096); }
+    ~TextWriter() { close(); }
+
+    bool open(const std::string& path) {
+        file_.open(path);
+        return file_.is_open();
+    }
+
+    template <typename T>
+    TextWriter& operator<<(const T& x) {
+        buffer_ << x;
+        if (buffer_.size() >= TEXT_WRITER_BLOCK) flush();
+        return *this;
+    }
+
+    // Appends a block formatted elsewhere.
+    void write(const TextBuffer& block) {
+        flush();
+        file_.write(block.data(), block.size());
+    }
+
+    void flush() {
+        if (buffer_.size() > 0) file_.write(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+
+    // Flushes and closes the file; returns false if any write failed.
+    bool close() {
+        if (!file_.is_open()) return false;
+        flush();
+        file_.close();
+        return !file_.fail();
+    }
+
+    TextBuffer& buffer() { return buffer_; }
+
+private:
+    std::ofstream file_;
+    TextBuffer buffer_;
+};
+
+// Writes count items, where format(i, buffer) appends the text of item i. With more than one
+// thread the items are formatted in rounds: in every round each thread formats the next
+// TEXT_WRITER_ITEMS_PER_ROUND items into its own buffer, and the buffers are written in
+// thread order, so the file is the same as with one thread.
+template <typename Format>
+void write_lines(TextWriter& out, size_t count, int threads, Format format) {
+    if (threads <= 1 || count < 2 * TEXT_WRITER_ITEMS_PER_ROUND) {
+        for (size_t i = 0; i < count; ++i) {
+            format(i, out.buffer());
+            if (out.buffer().size() >= TEXT_WRITER_BLOCK) out.flush();
+        }
+        return;
+    }
+
+    std::vector<TextBuffer> blocks(threads);
+    for (size_t base = 0; base < count; base += (size_t)threads * TEXT_WRITER_ITEMS_PER_ROUND) {
+        auto format_block = [&](int t) {
+            size_t begin = std::min(count, base + t * TEXT_WRITER_ITEMS_PER_ROUND);
+            size_t end = std::min(count, begin + TEXT_WRITER_ITEMS_PER_ROUND);
+            blocks[t].clear();
+            for (size_t i = begin; i < end; ++i) format(i, blocks[t]);
+        };
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; ++t) workers.emplace_back(format_block, t);
+        format_block(0);
+        for (auto& w : workers) w.join();
+        for (int t = 0; t < threads; ++t) out.write(blocks[t]);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+// Relabeling of a rooted tree so that node ids follow a traversal order.
+// In preorder every subtree is the contiguous id range [u, u + size(u)), and in BFS order every
+// level is contiguous; in both a parent has a smaller id than its children and the children of
+// a node keep their input order with increasing ids. Traversals, subtree queries and
+// conversions then become sequential scans over the arrays instead of jumps through the ids.
+
+enum class RelabelOrder { PREORDER, BFS };
+
+// The children of one node in the input, as a contiguous range of ids.
+struct IdRange {
+    const int* first;
+    const int* last;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+};
+
+struct RelabeledTree {
+    int n = 0;                 // Nodes reachable from the root; the root is node 0
+    std::vector<int> parent;   // parent[u], -1 for the root
+    std::vector<int> offset;   // Children of u are child[offset[u] .. offset[u+1]), in input order
+    std::vector<int> child;
+    std::vector<int> original; // original[u] = input id of node u
+};
+
+// Builds the relabeled tree from the input ids [0, id_count) rooted at root, where children(u)
+// returns the IdRange of u's children. O(n), without recursion.
+template <typename Children>
+RelabeledTree relabel_tree(int id_count, int root, Children children, RelabelOrder order) {
+    RelabeledTree t;
+    std::vector<int> new_id(id_count, -1);
+    if (root < 0 || root >= id_count) return t;
+
+    t.original.reserve(id_count);
+    t.parent.reserve(id_count);
+    if (order == RelabelOrder::BFS) {
+        // The output order is the queue itself
+        new_id[root] = 0;
+        t.original.push_back(root);
+        t.parent.push_back(-1);
+        for (int head = 0; head < (int)t.original.size(); ++head) {
+            for (int c : children(t.original[head])) {
+                if (new_id[c] != -1) continue; // Not a tree; keep the first parent
+                new_id[c] = (int)t.original.size();
+                t.original.push_back(c);
+                t.parent.push_back(head);
+            }
+        }
+    } else {
+        // Stack of (input id, new parent id); children are pushed last first so they pop in order
+        std::vector<std::pair<int, int>> stack;
+        stack.push_back({root, -1});
+        while (!stack.empty()) {
+            std::pair<int, int> top = stack.back();
+            stack.pop_back();
+            int u = top.first;
+            if (new_id[u] != -1) continue;
+            new_id[u] = (int)t.original.size();
+            t.original.push_back(u);
+            t.parent.push_back(top.second);
+            IdRange range = children(u);
+            for (const int* c = range.end(); c != range.begin();) {
+                --c;
+                if (new_id[*c] == -1) stack.push_back({*c, new_id[u]});
+            }
+        }
+    }
+    t.n = (int)t.original.size();
+
+    // Children lists by a counting sort on the new parents; ids grow along each sibling list,
+    // so filling in id order keeps the input order of the children.
+    t.offset.assign(t.n + 1, 0);
+    for (int v = 1; v < t.n; ++v) t.offset[t.parent[v] + 1]++;
+    for (int u = 0; u < t.n; ++u) t.offset[u + 1] += t.offset[u];
+    t.child.resize(t.offset[t.n]);
+    std::vector<int> pos(t.offset.begin(), t.offset.end() - 1);
+    for (int v = 1; v < t.n; ++v) t.child[pos[t.parent[v]]++] = v;
+    return t;
+}
+
+// Same for a tree given as children lists, tree[u] = children of u in input order.
+inline RelabeledTree relabel_tree(const std::vector<std::vector<int>>& tree, int root, RelabelOrder order) {
+    return relabel_tree((int)tree.size(), root, [&](int u) {
+        return IdRange{tree[u].data(), tree[u].data() + tree[u].size()};
+    }, order);
+}
+
+// Depth of every node: one forward scan, since parents come before their children.
+inline std::vector<int> node_depths(const RelabeledTree& t) {
+    std::vector<int> depth(t.n, 0);
+    for (int v = 1; v < t.n; ++v) depth[v] = depth[t.parent[v]] + 1;
+    return depth;
+}
+
+// Subtree size of every node: one backward scan. In preorder the subtree of u is [u, u + size[u]).
+inline std::vector<int> subtree_sizes(const RelabeledTree& t) {
+    std::vector<int> size(t.n, 1);
+    for (int v = t.n - 1; v > 0; --v) size[t.parent[v]] += size[v];
+    return size;
+}
+
+// Height of every node: one backward scan.
+inline std::vector<int> node_heights(const RelabeledTree& t) {
+    std::vector<int> height(t.n, 0);
+    for (int v = t.n - 1; v > 0; --v) {
+        if (height[v] + 1 > height[t.parent[v]]) height[t.parent[v]] = height[v] + 1;
+    }
+    return height;
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Triangle counting and clustering coefficients for the graphs of the represent tools.
+//
+// The input is given per vertex as a stream of (neighbor, multiplicity) pairs, in any order
+// and possibly repeated, which every representation can produce (an adjacency list repeats
+// a neighbor once per parallel edge, a multiplicity matrix gives the count directly).
+// Loops never close a triangle and are ignored. The engine reports two counts:
+//  - triangles: triangles of the underlying simple graph, each vertex triple at most once;
+//    the clustering coefficients are computed on this graph as well;
+//  - instances: triangles of the multigraph, where a triple counts
+//    mult(u,v) * mult(v,w) * mult(u,w), the number of distinct 3-cycles through its edges.
+// For a simple graph both counts are equal.
+//
+// Edges are oriented from lower to higher (degree, id) rank, so every vertex keeps at most
+// O(sqrt(m)) out-neighbors and every triangle is found exactly once, at its lowest vertex u,
+// as a common out-neighbor w of u and of an out-neighbor v of u. The out-lists are sorted by
+// id and intersected by merging; when u has many out-neighbors they are marked in a
+// per-thread array instead, so each out-list of v is scanned once with O(1) lookups.
+// Vertices are handed out to the threads in small chunks, since the work per vertex is skewed.
+
+struct TriangleStats {
+    uint64_t triangles = 0;
+    uint64_t instances = 0;
+    uint64_t wedges = 0;                  // Paths of length 2 in the simple graph
+    std::vector<uint64_t> per_vertex;     // Simple-graph triangles through every vertex
+    std::vector<double> clustering;       // Local clustering coefficient of every vertex
+    double average_clustering = 0;        // Mean of the local coefficients over all vertices
+    double transitivity = 0;              // 3 * triangles / wedges
+};
+
+// Out-degree from which the marking intersection replaces the merge.
+const int TRIANGLE_MARK_MIN_DEGREE = 32;
+
+namespace triangles_detail {
+
+// Runs body(t) on 'threads' threads; body 0 runs on the calling thread.
+template <typename Body>
+void on_threads(int threads, Body body) {
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) workers.emplace_back(body, t);
+    body(0);
+    for (auto& w : workers) w.join();
+}
+
+// Calls body(u) for every vertex, handing out chunks of vertices to the threads on demand.
+template <typename Body>
+void for_vertices(int n, int threads, Body body) {
+    const int chunk = 256;
+    std::atomic<int> next{0};
+    on_threads(threads, [&](int t) {
+        for (int begin; (begin = next.fetch_add(chunk)) < n;) {
+            int end = std::min(n, begin + chunk);
+            for (int u = begin; u < end; ++u) body(t, u);
+        }
+    });
+}
+
+// Collects the arcs of u without loops, sorted by neighbor with parallel arcs merged.
+template <typename ForEachNeighbor>
+void collapsed_neighbors(int u, ForEachNeighbor& for_each_neighbor, std::vector<std::pair<int, uint64_t>>& out) {
+    out.clear();
+    for_each_neighbor(u, [&](int v, uint64_t count) {
+        if (v != u && count > 0) out.push_back({v, count});
+    });
+    std::sort(out.begin(), out.end());
+    size_t k = 0;
+    for (size_t i = 0; i < out.size(); ++i) {
+        if (k > 0 && out[k - 1].first == out[i].first) out[k - 1].second += out[i].second;
+        else out[k++] = out[i];
+    }
+    out.resize(k);
+}
+
+} // namespace triangles_detail
+
+// for_each_neighbor(u, visit) must call visit(v, count) for the arcs of u; it is called
+// concurrently from several threads, twice per vertex.
+template <typename ForEachNeighbor>
+TriangleStats count_triangles(int n, ForEachNeighbor for_each_neighbor, int threads) {
+    using namespace triangles_detail;
+    TriangleStats stats;
+    threads = std::max(1, std::min(threads, n / 1024 + 1));
+
+    // Distinct neighbors and multiplicities in CSR form: count, prefix sum, fill
+    std::vector<long long> offset(n + 1, 0);
+    std::vector<std::vector<std::pair<int, uint64_t>>> scratch(threads);
+    for_vertices(n, threads, [&](int t, int u) {
+        collapsed_neighbors(u, for_each_neighbor, scratch[t]);
+        offset[u + 1] = (long long)scratch[t].size();
+    });
+    for (int u = 0; u < n; ++u) offset[u + 1] += offset[u];
+    std::vector<int> neighbor(offset[n]);
+    std::vector<uint64_t> multiplicity(offset[n]);
+    for_vertices(n, threads, [&](int t, int u) {
+        collapsed_neighbors(u, for_each_neighbor, scratch[t]);
+        for (size_t k = 0; k < scratch[t].size(); ++k) {
+            neighbor[offset[u] + k] = scratch[t][k].first;
+            multiplicity[offset[u] + k] = scratch[t][k].second;
+        }
+    });
+    scratch = std::vector<std::vector<std::pair<int, uint64_t>>>();
+
+    // Orientation: keep the neighbors of higher rank, still sorted by id
+    auto degree = [&](int u) { return offset[u + 1] - offset[u]; };
+    auto higher = [&](int u, int v) { return degree(v) > degree(u) || (degree(v) == degree(u) && v > u); };
+    std::vector<long long> out_offset(n + 1, 0);
+    for_vertices(n, threads, [&](int, int u) {
+        long long count = 0;
+        for (long long k = offset[u]; k < offset[u + 1]; ++k) count += higher(u, neighbor[k]);
+        out_offset[u + 1] = count;
+    });
+    for (int u = 0; u < n; ++u) out_offset[u + 1] += out_offset[u];
+    std::vector<int> out_neighbor(out_offset[n]);
+    std::vector<uint64_t> out_multiplicity(out_offset[n]);
+    for_vertices(n, threads, [&](int, int u) {
+        long long pos = out_offset[u];
+        for (long long k = offset[u]; k < offset[u + 1]; ++k) {
+            if (!higher(u, neighbor[k])) continue;
+            out_neighbor[pos] = neighbor[k];
+            out_multiplicity[pos++] = multiplicity[k];
+        }
+    });
+
+    std::unique_ptr<std::atomic<uint64_t>[]> through(new std::atomic<uint64_t>[n]);
+    for (int u = 0; u < n; ++u) through[u].store(0, std::memory_order_relaxed);
+    std::vector<uint64_t> thread_triangles(threads, 0), thread_instances(threads, 0);
+    std::vector<std::vector<int>> mark(threads); // Position in out(u) + 1, or 0
+
+    for_vertices(n, threads, [&](int t, int u) {
+        long long u_begin = out_offset[u], u_end = out_offset[u + 1];
+        if (u_end - u_begin < 2) return;
+        bool marking = u_end - u_begin >= TRIANGLE_MARK_MIN_DEGREE;
+        std::vector<int>& marks = mark[t];
+        if (marking) {
+            if (marks.empty()) marks.assign(n, 0);
+            for (long long k = u_begin; k < u_end; ++k) marks[out_neighbor[k]] = (int)(k - u_begin + 1);
+        }
+
+        uint64_t u_triangles = 0, u_instances = 0;
+        for (long long a = u_begin; a < u_end; ++a) {
+            int v = out_neighbor[a];
+            uint64_t uv = out_multiplicity[a];
+            uint64_t v_triangles = 0;
+            auto found = [&](long long uw_pos, long long vw_pos) {
+                int w = out_neighbor[vw_pos];
+                v_triangles++;
+                u_instances += uv * out_multiplicity[uw_pos] * out_multiplicity[vw_pos];
+                through[w].fetch_add(1, std::memory_order_relaxed);
+            };
+            if (marking) {
+                for (long long b = out_offset[v]; b < out_offset[v + 1]; ++b) {
+                    int at = marks[out_neighbor[b]];
+                    if (at != 0) found(u_begin + at - 1, b);
+                }
+            } else {
+                long long i = u_begin, j = out_offset[v], j_end = out_offset[v + 1];
+                while (i < u_end && j < j_end) {
+                    if (out_neighbor[i] < out_neighbor[j]) i++;
+                    else if (out_neighbor[i] > out_neighbor[j]) j++;
+                    else found(i++, j++);
+                }
+            }
+            if (v_triangles > 0) through[v].fetch_add(v_triangles, std::memory_order_relaxed);
+            u_triangles += v_triangles;
+        }
+        if (u_triangles > 0) through[u].fetch_add(u_triangles, std::memory_order_relaxed);
+        thread_triangles[t] += u_triangles;
+        thread_instances[t] += u_instances;
+
+        if (marking) {
+            for (long long k = u_begin; k < u_end; ++k) marks[out_neighbor[k]] = 0;
+        }
+    });
+
+    for (int t = 0; t < threads; ++t) {
+        stats.triangles += thread_triangles[t];
+        stats.instances += thread_instances[t];
+    }
+    stats.per_vertex.resize(n);
+    stats.clustering.resize(n);
+    double clustering_sum = 0;
+    for (int u = 0; u < n; ++u) {
+        uint64_t d = (uint64_t)degree(u);
+        uint64_t pairs = d * (d > 0 ? d - 1 : 0) / 2;
+        stats.per_vertex[u] = through[u].load(std::memory_order_relaxed);
+        stats.clustering[u] = pairs > 0 ? (double)stats.per_vertex[u] / pairs : 0.0;
+        stats.wedges += pairs;
+        clustering_sum += stats.clustering[u];
+    }
+    stats.average_clustering = n > 0 ? clustering_sum / n : 0.0;
+    stats.transitivity = stats.wedges > 0 ? 3.0 * stats.triangles / stats.wedges : 0.0;
+    return stats;
+}